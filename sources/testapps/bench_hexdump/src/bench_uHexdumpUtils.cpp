@@ -0,0 +1,314 @@
+
+#include "uHexdumpUtils.hpp"
+#include "uHexdumpLayout.hpp"
+#include "uHexdumpDiff.hpp"
+#include "uHexdumpReverse.hpp"
+#include "uArgsParser.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace legacy
+{
+
+// Previous HexDump3: one std::ostringstream and one printf per line
+inline void HexDump3(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine, bool bShowSpaces, bool bShowAscii, bool bShowOffset, bool bDecimalOffset)
+{
+    size_t szLines = szDataSize / szBytesPerLine;
+    size_t szLastLineLen = szDataSize % szBytesPerLine;
+
+    if (szLastLineLen != 0) ++szLines;
+
+    for (size_t i = 0; i < szLines; ++i) {
+        std::ostringstream ossline;
+        size_t szLineStart = i * szBytesPerLine;
+        size_t szLineLen = (i == szLines - 1 && szLastLineLen != 0) ? szLastLineLen : szBytesPerLine;
+
+        if (bShowOffset) {
+            if (bDecimalOffset) {
+                ossline << std::dec << std::setw(8) << std::setfill('0') << szLineStart << " | ";
+            } else {
+                ossline << std::hex << std::uppercase << std::setw(8) << std::setfill('0') << szLineStart << " | ";
+            }
+        }
+
+        for (size_t j = 0; j < szBytesPerLine; ++j) {
+            if (j < szLineLen) {
+                ossline << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << static_cast<int>(pData[szLineStart + j]);
+                if (bShowSpaces) {
+                    ossline << ' ';
+                }
+            } else {
+                ossline << (bShowSpaces ? "   " : "  ");
+            }
+        }
+
+        if (bShowAscii) {
+            ossline << " | ";
+            for (size_t j = 0; j < szLineLen; ++j) {
+                uint8_t ch = pData[szLineStart + j];
+                ossline << (std::isprint(ch) ? static_cast<char>(ch) : '.');
+            }
+        }
+
+        std::printf("%s\n", ossline.str().c_str());
+    }
+}
+
+} // namespace legacy
+
+struct BenchOptions
+{
+    size_t szSize = 16 * 1024 * 1024;
+    size_t szBytesPerLine = 16;
+    int iRuns = 3;
+    std::string strSink = "/dev/null";
+    hexutils::HexDumpColor eColor = hexutils::HexDumpColor::Always;
+    unsigned uThreads = 0;
+};
+
+// Parses sizes like 4096, 64K, 16M, 1G
+static size_t parse_size(const std::string& strValue)
+{
+    size_t szPos = 0;
+    size_t szValue = std::stoull(strValue, &szPos);
+    if (szPos < strValue.size()) {
+        switch (strValue[szPos] | 0x20) {
+            case 'k': szValue <<= 10; break;
+            case 'm': szValue <<= 20; break;
+            case 'g': szValue <<= 30; break;
+            default: break;
+        }
+    }
+    return szValue;
+}
+
+static std::vector<uint8_t> make_bytes(size_t szBytes)
+{
+    std::vector<uint8_t> data(szBytes);
+    for (size_t i = 0; i < szBytes; ++i) {
+        data[i] = static_cast<uint8_t>((0x9E3779B97F4A7C15ULL * (i + 1)) >> 56);
+    }
+    return data;
+}
+
+// Runs fn with stdout redirected to the sink, keeps the best of the runs in seconds
+template<typename Fn>
+static double measure(const BenchOptions& options, Fn&& fn)
+{
+    using Clock = std::chrono::steady_clock;
+
+    int iSinkFd = open(options.strSink.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (iSinkFd < 0) {
+        std::cerr << "cannot open " << options.strSink << std::endl;
+        return 0.0;
+    }
+
+    std::fflush(stdout);
+    int iSavedFd = dup(fileno(stdout));
+    dup2(iSinkFd, fileno(stdout));
+
+    double dBest = 0.0;
+    for (int iRun = 0; iRun < options.iRuns; ++iRun) {
+        lseek(fileno(stdout), 0, SEEK_SET);
+        auto start = Clock::now();
+        fn();
+        std::fflush(stdout);
+        double dElapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        dBest = (0 == iRun) ? dElapsed : std::min(dBest, dElapsed);
+    }
+
+    dup2(iSavedFd, fileno(stdout));
+    close(iSavedFd);
+    close(iSinkFd);
+    return dBest;
+}
+
+int main(int argc, const char* argv[])
+{
+    CommandLineParser cli("Hexdump benchmark: printf based HexDump1/2 and the previous HexDump3 against the buffered renderer");
+    cli.add_option("size", "Input size, e.g. 1M or 64M (default 16M)");
+    cli.add_option("bytes-per-line", "Bytes per line (default 16)");
+    cli.add_option("runs", "Runs per case, the best one is reported (default 3)");
+    cli.add_option("sink", "File receiving the dumps (default /dev/null)");
+    cli.add_option("color", "Color escapes: always, never or auto (default always, as on a terminal)");
+    cli.add_option("threads", "Threads of the parallel dump (default: all cores)");
+    cli.add_option("help", "Show this help");
+    cli.parse(argc, argv);
+
+    if (cli.has("help")) {
+        cli.print_usage();
+        return 0;
+    }
+
+    BenchOptions options;
+    if (auto value = cli.get("size")) {
+        options.szSize = parse_size(*value);
+    }
+    if (auto value = cli.get("bytes-per-line")) {
+        options.szBytesPerLine = std::max<size_t>(std::stoull(*value), 1);
+    }
+    if (auto value = cli.get("runs")) {
+        options.iRuns = std::max(std::stoi(*value), 1);
+    }
+    if (auto value = cli.get("sink")) {
+        options.strSink = *value;
+    }
+    if (auto value = cli.get("color")) {
+        options.eColor = ("never" == *value) ? hexutils::HexDumpColor::Never :
+                         ("auto" == *value)  ? hexutils::HexDumpColor::Auto : hexutils::HexDumpColor::Always;
+    }
+    if (auto value = cli.get("threads")) {
+        options.uThreads = static_cast<unsigned>(std::stoul(*value));
+    }
+    hexutils::HexDumpSetColor(options.eColor);
+
+    struct Variant {
+        const char* pstrName;
+        void (*pfnLegacy)(const uint8_t*, size_t, size_t, bool, bool, bool, bool);
+        hexutils::HexDumpStyle eStyle;
+    };
+    const Variant variants[] = {
+        {"HexDump1", hexutils::HexDump1, hexutils::HexDumpStyle::PerByteColors},
+        {"HexDump2", hexutils::HexDump2, hexutils::HexDumpStyle::SectionColors},
+        {"HexDump3", legacy::HexDump3, hexutils::HexDumpStyle::Plain}};
+
+    std::vector<uint8_t> data = make_bytes(options.szSize);
+
+    std::cout << "Hexdump benchmark, " << options.szSize << " bytes, " << options.szBytesPerLine << " bytes per line" << std::endl;
+    std::cout << std::left << std::setw(10) << "variant" << std::right
+              << std::setw(14) << "printf ms" << std::setw(14) << "buffered ms"
+              << std::setw(14) << "printf MB/s" << std::setw(14) << "buffered MB/s" << std::setw(10) << "speedup" << std::endl;
+
+    for (const Variant& variant : variants) {
+        hexutils::HexDumpOptions dumpOptions;
+        dumpOptions.szBytesPerLine = options.szBytesPerLine;
+        dumpOptions.eStyle = variant.eStyle;
+        dumpOptions.eColor = options.eColor;
+
+        double dLegacy = measure(options, [&]() {
+            variant.pfnLegacy(data.data(), data.size(), options.szBytesPerLine, true, true, true, false);
+        });
+        double dBuffered = measure(options, [&]() {
+            hexutils::HexDumpBuffered(data.data(), data.size(), dumpOptions);
+        });
+
+        double dMegabytes = static_cast<double>(options.szSize) / 1e6;
+        std::cout << std::left << std::setw(10) << variant.pstrName << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << dLegacy * 1e3 << std::setw(14) << dBuffered * 1e3
+                  << std::setw(14) << dMegabytes / dLegacy << std::setw(14) << dMegabytes / dBuffered
+                  << std::setw(9) << dLegacy / dBuffered << "x" << std::endl;
+    }
+
+    // parallel formatting against the single-threaded renderer, same layout
+    hexutils::HexDumpOptions dumpOptions;
+    dumpOptions.szBytesPerLine = options.szBytesPerLine;
+    dumpOptions.eColor = options.eColor;
+    hexutils::HexDumpParallelOptions parallel;
+    parallel.uThreads = options.uThreads;
+    parallel.szThreshold = 0;
+
+    double dSerial = measure(options, [&]() {
+        hexutils::HexDumpBuffered(data.data(), data.size(), dumpOptions);
+    });
+    double dParallel = measure(options, [&]() {
+        hexutils::HexDumpParallel(data.data(), data.size(), dumpOptions, parallel);
+    });
+
+    double dMegabytes = static_cast<double>(options.szSize) / 1e6;
+    unsigned uThreads = (0 != options.uThreads) ? options.uThreads : std::max(std::thread::hardware_concurrency(), 1U);
+    std::cout << std::endl << "HexDumpParallel, " << uThreads << " threads" << std::endl
+              << std::left << std::setw(10) << "variant" << std::right
+              << std::setw(14) << "serial ms" << std::setw(14) << "parallel ms"
+              << std::setw(14) << "serial MB/s" << std::setw(14) << "parallel MB/s" << std::setw(10) << "speedup" << std::endl
+              << std::left << std::setw(10) << "HexDump1" << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << dSerial * 1e3 << std::setw(14) << dParallel * 1e3
+              << std::setw(14) << dMegabytes / dSerial << std::setw(14) << dMegabytes / dParallel
+              << std::setw(9) << dSerial / dParallel << "x" << std::endl;
+
+    // annotated dumps: a frame header only, then one field every 64 bytes of the input
+    hexutils::HexDumpLayout header;
+    header.add("sync", "0, x16, be");
+    header.add("length", "2, u32, be");
+    header.add("payload", "6, 10, bytes");
+    hexutils::HexDumpLayout dense;
+    for (size_t szOffset = 0; szOffset + 8 <= data.size(); szOffset += 64) {
+        dense.add({szOffset, 8, "value", hexutils::HexFieldType::Unsigned, hexutils::Endianness::Little});
+    }
+
+    double dHeader = measure(options, [&]() {
+        hexutils::HexDumpAnnotated(data.data(), data.size(), header, dumpOptions);
+    });
+    double dDense = measure(options, [&]() {
+        hexutils::HexDumpAnnotated(data.data(), data.size(), dense, dumpOptions);
+    });
+
+    std::cout << std::endl << "HexDumpAnnotated" << std::endl
+              << std::left << std::setw(10) << "layout" << std::right
+              << std::setw(14) << "raw ms" << std::setw(14) << "annotated ms"
+              << std::setw(14) << "raw MB/s" << std::setw(14) << "annot. MB/s" << std::setw(10) << "ratio" << std::endl;
+    for (const auto& [pstrName, dAnnotated] : {std::pair<const char*, double>{"header", dHeader}, {"dense", dDense}}) {
+        std::cout << std::left << std::setw(10) << pstrName << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << dSerial * 1e3 << std::setw(14) << dAnnotated * 1e3
+                  << std::setw(14) << dMegabytes / dSerial << std::setw(14) << dMegabytes / dAnnotated
+                  << std::setw(9) << dSerial / dAnnotated << "x" << std::endl;
+    }
+
+    // diff dumps: identical inputs (pure compare), then one changed byte every 64 KiB
+    std::vector<uint8_t> other(data);
+    for (size_t szOffset = 0; szOffset < other.size(); szOffset += 64 * 1024) {
+        other[szOffset] ^= 0xFF;
+    }
+
+    double dIdentical = measure(options, [&]() {
+        hexutils::HexDiff(data.data(), data.size(), data.data(), data.size(), dumpOptions);
+    });
+    double dSparse = measure(options, [&]() {
+        hexutils::HexDiff(data.data(), data.size(), other.data(), other.size(), dumpOptions);
+    });
+
+    std::cout << std::endl << "HexDiff" << std::endl
+              << std::left << std::setw(10) << "inputs" << std::right
+              << std::setw(14) << "raw ms" << std::setw(14) << "diff ms"
+              << std::setw(14) << "raw MB/s" << std::setw(14) << "diff MB/s" << std::setw(10) << "ratio" << std::endl;
+    for (const auto& [pstrName, dDiff] : {std::pair<const char*, double>{"identical", dIdentical}, {"sparse", dSparse}}) {
+        std::cout << std::left << std::setw(10) << pstrName << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << dSerial * 1e3 << std::setw(14) << dDiff * 1e3
+                  << std::setw(14) << dMegabytes / dSerial << std::setw(14) << dMegabytes / dDiff
+                  << std::setw(9) << dSerial / dDiff << "x" << std::endl;
+    }
+
+    // reverse dumps: the bytes rebuilt from the plain and the colored text, MB/s of rebuilt bytes
+    std::cout << std::endl << "HexDumpReverse" << std::endl
+              << std::left << std::setw(10) << "dump" << std::right
+              << std::setw(14) << "text MB" << std::setw(14) << "reverse ms" << std::setw(14) << "text MB/s" << std::setw(14) << "bytes MB/s" << std::endl;
+    for (hexutils::HexDumpColor eColor : {hexutils::HexDumpColor::Never, hexutils::HexDumpColor::Always}) {
+        hexutils::HexDumpOptions reverseOptions = dumpOptions;
+        reverseOptions.eColor = eColor;
+        const std::string strDump = hexutils::HexDumpString(data.data(), data.size(), reverseOptions);
+        std::vector<uint8_t> rebuilt;
+        rebuilt.reserve(data.size());
+
+        double dReverse = measure(options, [&]() {
+            rebuilt.clear();
+            hexutils::HexDumpReverse(strDump, rebuilt, reverseOptions);
+        });
+
+        double dTextMegabytes = static_cast<double>(strDump.size()) / 1e6;
+        std::cout << std::left << std::setw(10) << ((hexutils::HexDumpColor::Never == eColor) ? "plain" : "colored") << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << dTextMegabytes << std::setw(14) << dReverse * 1e3
+                  << std::setw(14) << dTextMegabytes / dReverse << std::setw(14) << dMegabytes / dReverse
+                  << ((rebuilt == data) ? "" : "  (mismatch)") << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,404 @@
+
+#include "uHexlifyUtils.hpp"
+#include "uBaseNUtils.hpp"
+#include "uArgsParser.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+
+namespace legacy
+{
+
+// Previous string_hexlify_any: one push_back per character, element bytes reversed one by one
+template<typename T>
+bool string_hexlify_any(const std::vector<T>& data, std::string& out, hexutils::Endianness endian)
+{
+    out.clear();
+    out.reserve(data.size() * sizeof(T) * 2 + 2);
+
+    uint8_t marker = (endian == hexutils::Endianness::Little) ? 0x4C : 0x42;
+    out.push_back(hexutils::internal::g_pstrHexDigits[(marker >> 4) & 0xF]);
+    out.push_back(hexutils::internal::g_pstrHexDigits[marker & 0xF]);
+
+    bool systemIsLE = hexutils::internal::is_system_little_endian();
+    bool swap = (endian == hexutils::Endianness::Big) == systemIsLE;
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        const uint8_t* elemPtr = reinterpret_cast<const uint8_t*>(&data[i]);
+        for (size_t j = 0; j < sizeof(T); ++j) {
+            uint8_t byte = elemPtr[swap ? sizeof(T) - 1 - j : j];
+            out.push_back(hexutils::internal::g_pstrHexDigits[(byte >> 4) & 0xF]);
+            out.push_back(hexutils::internal::g_pstrHexDigits[byte & 0xF]);
+        }
+    }
+    return true;
+}
+
+// Previous string_unhexlify_any: decode into a temporary, reverse every element, copy into the result
+template<typename T>
+bool string_unhexlify_any(const std::string& hex, std::vector<T>& result)
+{
+    uint8_t marker = (hexutils::internal::hex_char_to_byte(hex[0]) << 4) | hexutils::internal::hex_char_to_byte(hex[1]);
+    hexutils::Endianness targetEndian = (marker == 0x4C) ? hexutils::Endianness::Little : hexutils::Endianness::Big;
+
+    size_t byteCount = (hex.size() - 2) / 2;
+    std::vector<uint8_t> bytes;
+    bytes.reserve(byteCount);
+    for (size_t i = 0; i < byteCount; ++i) {
+        uint8_t high = hexutils::internal::hex_char_to_byte(hex[2 + 2 * i]);
+        uint8_t low  = hexutils::internal::hex_char_to_byte(hex[2 + 2 * i + 1]);
+        if ((high | low) & 0xF0) {
+            return false;
+        }
+        bytes.push_back((high << 4) | low);
+    }
+
+    bool systemIsLE = hexutils::internal::is_system_little_endian();
+    if ((targetEndian == hexutils::Endianness::Big) == systemIsLE) {
+        for (size_t i = 0; i < byteCount; i += sizeof(T)) {
+            std::reverse(bytes.begin() + i, bytes.begin() + i + sizeof(T));
+        }
+    }
+
+    result.clear();
+    result.resize(byteCount / sizeof(T));
+    std::memcpy(result.data(), bytes.data(), byteCount);
+    return true;
+}
+
+} // namespace legacy
+
+struct BenchOptions
+{
+    size_t szMinSize = 16;
+    size_t szMaxSize = 64 * 1024 * 1024;
+    double dMinSeconds = 0.1;
+    bool bLegacy = true;
+    bool bCodecs = true;
+};
+
+struct BenchRecord
+{
+    std::string strGroup;      // core, legacy, codec
+    std::string strName;       // e.g. string_unhexlify
+    std::string strType;       // element type, or "-"
+    std::string strInput;      // valid / invalid
+    size_t szSize;             // input size in bytes (binary side of the conversion)
+    size_t szIterations;       // number of timed calls
+    double dNsPerCall;         // best time per call
+    double dGBps;              // szSize / best time
+};
+
+static std::vector<BenchRecord> g_vRecords;
+
+// Parses sizes like 4096, 64K, 16M, 1G
+static size_t parse_size(const std::string& strValue)
+{
+    size_t szPos = 0;
+    size_t szValue = std::stoull(strValue, &szPos);
+    if (szPos < strValue.size()) {
+        switch (strValue[szPos] | 0x20) {
+            case 'k': szValue <<= 10; break;
+            case 'm': szValue <<= 20; break;
+            case 'g': szValue <<= 30; break;
+            default: break;
+        }
+    }
+    return szValue;
+}
+
+static std::string size_label(size_t szBytes)
+{
+    static const char* apstrUnits[] = {"B", "KiB", "MiB", "GiB"};
+    int iUnit = 0;
+    while ((szBytes >= 1024) && (szBytes % 1024 == 0) && (iUnit < 3)) {
+        szBytes /= 1024;
+        ++iUnit;
+    }
+    return std::to_string(szBytes) + " " + apstrUnits[iUnit];
+}
+
+static const char* kernel_name()
+{
+    const hexutils::internal::HexKernels& kernels = hexutils::internal::hex_kernels();
+#if defined(uHEXLIFY_SIMD_X86)
+    if (kernels.pfnDecode == hexutils::internal::hex_decode_avx2) {
+        return "avx2";
+    }
+    if (kernels.pfnDecode == hexutils::internal::hex_decode_sse2) {
+        return "sse2";
+    }
+#elif defined(uHEXLIFY_SIMD_NEON)
+    if (kernels.pfnDecode == hexutils::internal::hex_decode_neon) {
+        return "neon";
+    }
+#endif
+    (void)kernels;
+    return "scalar";
+}
+
+// Times fn in batches long enough for the clock, keeps the best time per call
+template<typename Fn>
+void measure(const BenchOptions& options, const std::string& strGroup, const std::string& strName, const std::string& strType,
+             const std::string& strInput, size_t szSize, Fn&& fn)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr double dMinBatchSeconds = 0.002;
+
+    size_t szBatch = 1;
+    double dBatch = 0.0;
+    for (;;) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < szBatch; ++i) {
+            fn();
+        }
+        dBatch = std::chrono::duration<double>(Clock::now() - start).count();
+        if ((dBatch >= dMinBatchSeconds) || (szBatch >= (size_t(1) << 30))) {
+            break;
+        }
+        szBatch *= 2;
+    }
+
+    double dBest = dBatch / static_cast<double>(szBatch);
+    double dTotal = dBatch;
+    size_t szIterations = szBatch;
+    for (int iRun = 1; (iRun < 3) || (dTotal < options.dMinSeconds); ++iRun) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < szBatch; ++i) {
+            fn();
+        }
+        double dElapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        dBest = std::min(dBest, dElapsed / static_cast<double>(szBatch));
+        dTotal += dElapsed;
+        szIterations += szBatch;
+    }
+
+    g_vRecords.push_back({strGroup, strName, strType, strInput, szSize, szIterations, dBest * 1e9,
+                          static_cast<double>(szSize) / dBest / 1e9});
+}
+
+static std::vector<uint8_t> make_bytes(size_t szBytes)
+{
+    std::vector<uint8_t> data(szBytes);
+    for (size_t i = 0; i < szBytes; ++i) {
+        data[i] = static_cast<uint8_t>((0x9E3779B97F4A7C15ULL * (i + 1)) >> 56);
+    }
+    return data;
+}
+
+// Invalid input: the last character is corrupted, so the decoder scans everything before failing
+static std::string corrupt_last(std::string str)
+{
+    if (!str.empty()) {
+        str.back() = 'G';
+    }
+    return str;
+}
+
+static void bench_core_bytes(const BenchOptions& options, size_t szSize)
+{
+    std::vector<uint8_t> data = make_bytes(szSize);
+    std::string hex;
+    std::vector<uint8_t> decoded;
+
+    measure(options, "core", "string_hexlify", "uint8_t", "valid", szSize, [&]() { hexutils::string_hexlify(data, 0, data.size(), hex); });
+
+    const std::string invalid = corrupt_last(hex);
+    measure(options, "core", "string_unhexlify", "uint8_t", "valid", szSize, [&]() { hexutils::string_unhexlify(hex, decoded); });
+    measure(options, "core", "string_unhexlify", "uint8_t", "invalid", szSize, [&]() { hexutils::string_unhexlify(invalid, decoded); });
+}
+
+template<typename T>
+void bench_core_any(const BenchOptions& options, const char* pstrType, size_t szSize)
+{
+    std::vector<T> data(szSize / sizeof(T));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<T>(0x9E3779B97F4A7C15ULL * (i + 1));
+    }
+    std::string hex;
+    std::vector<T> decoded;
+
+    for (hexutils::Endianness endian : {hexutils::Endianness::Little, hexutils::Endianness::Big}) {
+        std::string strType = std::string(pstrType) + ((endian == hexutils::Endianness::Little) ? " LE" : " BE");
+        measure(options, "core", "string_hexlify_any", strType, "valid", szSize, [&]() { hexutils::string_hexlify_any(data, hex, endian); });
+
+        const std::string invalid = corrupt_last(hex);
+        measure(options, "core", "string_unhexlify_any", strType, "valid", szSize, [&]() { hexutils::string_unhexlify_any(hex, decoded); });
+        measure(options, "core", "string_unhexlify_any", strType, "invalid", szSize, [&]() { hexutils::string_unhexlify_any(invalid, decoded); });
+    }
+}
+
+template<typename T>
+void bench_legacy_any(const BenchOptions& options, const char* pstrType, size_t szSize)
+{
+    std::vector<T> data(szSize / sizeof(T));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<T>(0x9E3779B97F4A7C15ULL * (i + 1));
+    }
+    std::string hex;
+    std::vector<T> decoded;
+
+    for (hexutils::Endianness endian : {hexutils::Endianness::Little, hexutils::Endianness::Big}) {
+        std::string strType = std::string(pstrType) + ((endian == hexutils::Endianness::Little) ? " LE" : " BE");
+        measure(options, "legacy", "string_hexlify_any", strType, "valid", szSize, [&]() { legacy::string_hexlify_any(data, hex, endian); });
+        measure(options, "legacy", "string_unhexlify_any", strType, "valid", szSize, [&]() { legacy::string_unhexlify_any(hex, decoded); });
+    }
+}
+
+template<typename Codec>
+void bench_codec(const BenchOptions& options, const char* pstrName, const Codec& codec, const std::vector<uint8_t>& data)
+{
+    std::string encoded;
+    std::vector<uint8_t> decoded;
+
+    measure(options, "codec", std::string(pstrName) + " encode", "uint8_t", "valid", data.size(),
+            [&]() { basenutils::string_encode(codec, data, 0, data.size(), encoded); });
+    measure(options, "codec", std::string(pstrName) + " decode", "uint8_t", "valid", data.size(),
+            [&]() { basenutils::string_decode(codec, encoded, decoded); });
+}
+
+static void bench_codecs(const BenchOptions& options, size_t szSize)
+{
+    std::vector<uint8_t> data = make_bytes(szSize);
+    std::string hex;
+    std::vector<uint8_t> decoded;
+
+    measure(options, "codec", "hex encode", "uint8_t", "valid", szSize, [&]() { hexutils::string_hexlify(data, 0, data.size(), hex); });
+    measure(options, "codec", "hex decode", "uint8_t", "valid", szSize, [&]() { hexutils::string_unhexlify(hex, decoded); });
+    measure(options, "codec", "hex parallel encode", "uint8_t", "valid", szSize,
+            [&]() { hexutils::string_hexlify_parallel(data, 0, data.size(), hex, {.szThreshold = 0}); });
+
+    const hexutils::HexFormat grouped{.strBytePrefix = "", .strSeparator = "", .szGroupSize = 16, .strGroupSeparator = "\n", .bLowercase = true};
+    measure(options, "codec", "hex 16/line encode", "uint8_t", "valid", szSize, [&]() { hexutils::string_hexlify(data, 0, data.size(), hex, grouped); });
+    measure(options, "codec", "hex 16/line decode", "uint8_t", "valid", szSize, [&]() { hexutils::string_unhexlify_tolerant(hex, decoded); });
+
+    const hexutils::HexFormat separated{.strBytePrefix = "0x", .strSeparator = ", ", .szGroupSize = 0, .strGroupSeparator = "", .bLowercase = false};
+    measure(options, "codec", "hex 0xAA, encode", "uint8_t", "valid", szSize, [&]() { hexutils::string_hexlify(data, 0, data.size(), hex, separated); });
+    measure(options, "codec", "hex 0xAA, decode", "uint8_t", "valid", szSize, [&]() { hexutils::string_unhexlify_tolerant(hex, decoded); });
+
+    bench_codec(options, "base64", basenutils::Base64Codec{}, data);
+    bench_codec(options, "base64url", basenutils::Base64Codec{basenutils::Base64Alphabet::UrlSafe, false}, data);
+    bench_codec(options, "base32", basenutils::Base32Codec{}, data);
+    bench_codec(options, "ascii85", basenutils::Base85Codec{basenutils::Base85Variant::Ascii85}, data);
+    bench_codec(options, "z85", basenutils::Base85Codec{basenutils::Base85Variant::Z85}, data);
+}
+
+static void write_text(std::ostream& os)
+{
+    std::string strGroup;
+    for (const BenchRecord& record : g_vRecords) {
+        if (record.strGroup != strGroup) {
+            strGroup = record.strGroup;
+            os << std::endl << "[" << strGroup << "]" << std::endl;
+        }
+        os << std::left << std::setw(24) << record.strName << std::setw(12) << record.strType << std::setw(9) << record.strInput
+           << std::right << std::setw(10) << size_label(record.szSize)
+           << std::fixed << std::setprecision(1) << std::setw(14) << record.dNsPerCall << " ns"
+           << std::setprecision(3) << std::setw(10) << record.dGBps << " GB/s" << std::endl;
+    }
+}
+
+static void write_csv(std::ostream& os)
+{
+    os << "group,benchmark,type,input,size_bytes,iterations,ns_per_call,gb_per_s" << std::endl;
+    for (const BenchRecord& record : g_vRecords) {
+        os << record.strGroup << ',' << record.strName << ',' << record.strType << ',' << record.strInput << ','
+           << record.szSize << ',' << record.szIterations << ',' << std::fixed << std::setprecision(1) << record.dNsPerCall << ','
+           << std::setprecision(4) << record.dGBps << std::endl;
+    }
+}
+
+static void write_json(std::ostream& os)
+{
+    os << "{" << std::endl << "  \"benchmark\": \"bench_hexlify\"," << std::endl
+       << "  \"kernel\": \"" << kernel_name() << "\"," << std::endl << "  \"results\": [" << std::endl;
+    for (size_t i = 0; i < g_vRecords.size(); ++i) {
+        const BenchRecord& record = g_vRecords[i];
+        os << "    {\"group\": \"" << record.strGroup << "\", \"benchmark\": \"" << record.strName << "\", \"type\": \"" << record.strType
+           << "\", \"input\": \"" << record.strInput << "\", \"size_bytes\": " << record.szSize << ", \"iterations\": " << record.szIterations
+           << ", \"ns_per_call\": " << std::fixed << std::setprecision(1) << record.dNsPerCall
+           << ", \"gb_per_s\": " << std::setprecision(4) << record.dGBps << "}" << ((i + 1 < g_vRecords.size()) ? "," : "") << std::endl;
+    }
+    os << "  ]" << std::endl << "}" << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+    CommandLineParser cli("Hexlify / unhexlify benchmark");
+    cli.add_option("min-size", "Smallest input size, e.g. 16 (default 16)");
+    cli.add_option("max-size", "Largest input size, e.g. 64M or 1G (default 64M); inputs grow 4x per step");
+    cli.add_option("min-time", "Minimum measuring time per case in milliseconds (default 100)");
+    cli.add_option("format", "Output format: text, csv or json (default text)");
+    cli.add_option("output", "Output file (default stdout)");
+    cli.add_option("core-only", "Skip the legacy and base-N codec comparisons");
+    cli.add_option("help", "Show this help");
+    cli.parse(argc, argv);
+
+    if (cli.has("help")) {
+        cli.print_usage();
+        return 0;
+    }
+
+    BenchOptions options;
+    if (auto value = cli.get("min-size")) {
+        options.szMinSize = std::max<size_t>(parse_size(*value), 16);
+    }
+    if (auto value = cli.get("max-size")) {
+        options.szMaxSize = parse_size(*value);
+    }
+    if (auto value = cli.get("min-time")) {
+        options.dMinSeconds = std::stod(*value) / 1000.0;
+    }
+    if (cli.has("core-only")) {
+        options.bLegacy = false;
+        options.bCodecs = false;
+    }
+    std::string strFormat = cli.get("format").value_or("text");
+
+    // 16 B, 64 B, ... up to the maximum size
+    for (size_t szSize = options.szMinSize; szSize <= options.szMaxSize; szSize *= 4) {
+        std::cerr << "core " << size_label(szSize) << std::endl;
+        bench_core_bytes(options, szSize);
+        bench_core_any<uint32_t>(options, "uint32_t", szSize);
+        bench_core_any<uint64_t>(options, "uint64_t", szSize);
+    }
+
+    // the comparisons run at a single, cache-exceeding size
+    const size_t szCompareSize = std::min<size_t>(options.szMaxSize, 16 * 1024 * 1024);
+    if (options.bLegacy) {
+        std::cerr << "legacy " << size_label(szCompareSize) << std::endl;
+        bench_legacy_any<uint32_t>(options, "uint32_t", szCompareSize);
+        bench_legacy_any<uint64_t>(options, "uint64_t", szCompareSize);
+    }
+    if (options.bCodecs) {
+        std::cerr << "codecs " << size_label(szCompareSize) << std::endl;
+        bench_codecs(options, szCompareSize);
+    }
+
+    std::ofstream file;
+    if (auto value = cli.get("output")) {
+        file.open(*value);
+        if (!file) {
+            std::cerr << "cannot open " << *value << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = file.is_open() ? static_cast<std::ostream&>(file) : std::cout;
+
+    if ("csv" == strFormat) {
+        write_csv(os);
+    } else if ("json" == strFormat) {
+        write_json(os);
+    } else {
+        os << "Hexlify benchmark, kernel: " << kernel_name() << std::endl;
+        write_text(os);
+    }
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include "uBaseNUtils.hpp"
+
+static std::vector<uint8_t> to_bytes(const std::string& str)
+{
+    return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+static std::vector<uint8_t> make_pattern(size_t size)
+{
+    std::vector<uint8_t> buffer(size);
+    for (size_t i = 0; i < size; ++i) {
+        buffer[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    return buffer;
+}
+
+template<typename Codec>
+static bool check_vectors(const Codec& codec, const std::vector<std::pair<std::string, std::string>>& vectors)
+{
+    bool match = true;
+    for (const auto& [plain, encoded] : vectors) {
+        std::vector<uint8_t> input = to_bytes(plain);
+        std::string out;
+        std::vector<uint8_t> decoded;
+        basenutils::string_encode(codec, input, 0, input.size(), out);
+        match = match && (out == encoded);
+        match = match && basenutils::string_decode(codec, encoded, decoded) && (decoded == input);
+    }
+    return match;
+}
+
+void test_base64_vectors()
+{
+    // RFC 4648, section 10
+    std::vector<std::pair<std::string, std::string>> padded = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"}};
+    std::vector<std::pair<std::string, std::string>> unpadded = {
+        {"f", "Zg"}, {"fo", "Zm8"}, {"foobar", "Zm9vYmFy"}, {"\xfb\xff", "-_8"}};
+
+    bool match = check_vectors(basenutils::Base64Codec{}, padded) &&
+                 check_vectors(basenutils::Base64Codec{basenutils::Base64Alphabet::UrlSafe, false}, unpadded);
+
+    // unpadded input is accepted by the padded codec too
+    std::vector<uint8_t> decoded;
+    match = match && basenutils::string_base64_decode("Zm8", decoded) && (decoded == to_bytes("fo"));
+
+    std::cout << "Test base64 vectors: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_base32_vectors()
+{
+    std::vector<std::pair<std::string, std::string>> vectors = {
+        {"", ""}, {"f", "MY======"}, {"fo", "MZXQ===="}, {"foo", "MZXW6==="}, {"foob", "MZXW6YQ="}, {"fooba", "MZXW6YTB"}, {"foobar", "MZXW6YTBOI======"}};
+
+    std::cout << "Test base32 vectors: " << (check_vectors(basenutils::Base32Codec{}, vectors) ? "Passed" : "Failed") << std::endl;
+}
+
+void test_base85_vectors()
+{
+    std::vector<std::pair<std::string, std::string>> ascii85 = {
+        {"", ""}, {"Man ", "9jqo^"}, {"Man", "9jqo"}, {"sure.", "F*2M7/c"}, {std::string(4, '\0'), "z"}, {std::string(5, '\0'), "z!!"}};
+    bool match = check_vectors(basenutils::Base85Codec{basenutils::Base85Variant::Ascii85}, ascii85);
+
+    // ZeroMQ RFC 32 test vector
+    std::vector<uint8_t> z85Input = {0x86, 0x4F, 0xD2, 0x6F, 0xB5, 0x59, 0xF7, 0x5B};
+    std::string z85;
+    std::vector<uint8_t> decoded;
+    match = match && basenutils::string_z85_encode(z85Input, 0, z85Input.size(), z85) && (z85 == "HelloWorld");
+    match = match && basenutils::string_z85_decode(z85, decoded) && (decoded == z85Input);
+
+    // Z85 only accepts whole groups
+    match = match && !basenutils::string_z85_encode(z85Input, 0, 7, z85);
+    match = match && basenutils::string_z85_decode("Hello", decoded) && (decoded.size() == 4);
+    match = match && !basenutils::string_z85_decode("HelloWorl", decoded);
+
+    std::cout << "Test base85 vectors: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+template<typename Codec>
+static bool check_roundtrip(const Codec& codec)
+{
+    // sizes around the SIMD block widths exercise both the vector loops and the scalar tails
+    bool match = true;
+    for (size_t size : {0, 1, 2, 3, 4, 5, 23, 24, 31, 32, 33, 47, 48, 49, 95, 96, 97, 1000, 4099}) {
+        std::vector<uint8_t> buffer = make_pattern(size);
+        std::string encoded;
+        std::vector<uint8_t> decoded;
+        match = match && basenutils::string_encode(codec, buffer, 0, buffer.size(), encoded);
+        match = match && basenutils::string_decode(codec, encoded, decoded) && (decoded == buffer);
+    }
+    return match;
+}
+
+void test_basen_roundtrip()
+{
+    bool match = check_roundtrip(basenutils::Base64Codec{}) &&
+                 check_roundtrip(basenutils::Base64Codec{basenutils::Base64Alphabet::UrlSafe, false}) &&
+                 check_roundtrip(basenutils::Base32Codec{}) &&
+                 check_roundtrip(basenutils::Base32Codec{false}) &&
+                 check_roundtrip(basenutils::Base85Codec{basenutils::Base85Variant::Ascii85});
+
+    std::vector<uint8_t> buffer = make_pattern(4096);
+    std::string encoded;
+    std::vector<uint8_t> decoded;
+    match = match && basenutils::string_z85_encode(buffer, 0, buffer.size(), encoded);
+    match = match && basenutils::string_z85_decode(encoded, decoded) && (decoded == buffer);
+
+    std::cout << "Test base-N roundtrip: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_base64_invalid()
+{
+    // an invalid character at every position, inside and outside the SIMD blocks
+    std::vector<uint8_t> buffer = make_pattern(300);
+    std::string encoded;
+    basenutils::string_base64_encode(buffer, 0, buffer.size(), encoded);
+
+    bool match = true;
+    for (size_t pos = 0; pos < encoded.size(); ++pos) {
+        for (char bad : {'*', '-', '\x80'}) {
+            std::string corrupted = encoded;
+            corrupted[pos] = bad;
+            std::vector<uint8_t> decoded;
+            size_t szErrorOffset = 0;
+            bool bRetVal = basenutils::string_base64_decode(corrupted, decoded, {}, &szErrorOffset);
+            match = match && !bRetVal && (szErrorOffset == pos) && (decoded.size() == (pos / 4) * 3);
+        }
+    }
+
+    // URL-safe decoding rejects the standard-only characters
+    std::vector<uint8_t> decoded;
+    match = match && !basenutils::string_base64url_decode("ab+/", decoded);
+
+    // malformed lengths and padding
+    for (const char* pstrBad : {"A", "Zg=", "Z===", "Zg==Zg==", "Zm9vY"}) {
+        match = match && !basenutils::string_base64_decode(pstrBad, decoded);
+    }
+
+    std::cout << "Test base64 invalid input: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_basen_span()
+{
+    std::vector<uint8_t> input = to_bytes("foobar");
+    std::vector<char> out(8);
+    basenutils::Base64Codec codec;
+    size_t szWritten = basenutils::string_encode(codec, std::as_bytes(std::span<const uint8_t>(input)), std::span<char>(out));
+    bool match = (szWritten == 8) && (std::string(out.data(), szWritten) == "Zm9vYmFy");
+
+    std::vector<char> small(7);
+    match = match && (0 == basenutils::string_encode(codec, std::as_bytes(std::span<const uint8_t>(input)), std::span<char>(small)));
+
+    std::vector<std::byte> decoded(6);
+    basenutils::BaseNResult result = basenutils::string_decode(codec, "Zm9vYmFy", std::span<std::byte>(decoded));
+    match = match && result && (result.szWritten == 6) && (0 == std::memcmp(decoded.data(), input.data(), 6));
+
+    result = basenutils::string_decode(codec, "Zm9vYmFy", std::span<std::byte>(decoded.data(), 5));
+    match = match && (result.eStatus == basenutils::BaseNStatus::BufferTooSmall);
+
+    std::cout << "Test base-N span: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+template<typename Codec>
+static bool check_stream(const Codec& codec, size_t szChunk)
+{
+    std::vector<uint8_t> buffer = make_pattern(1000);
+    std::string expected;
+    basenutils::string_encode(codec, buffer, 0, buffer.size(), expected);
+
+    basenutils::BaseNEncoder<Codec> encoder(codec);
+    std::string encoded;
+    for (size_t i = 0; i < buffer.size(); i += szChunk) {
+        size_t szLen = std::min(szChunk, buffer.size() - i);
+        encoded += encoder.update(std::span<const uint8_t>(buffer.data() + i, szLen));
+    }
+    encoded += encoder.finish();
+
+    // feed the decoder with line breaks every 76 characters
+    std::string wrapped;
+    for (size_t i = 0; i < encoded.size(); i += 76) {
+        wrapped += encoded.substr(i, 76) + "\r\n";
+    }
+
+    basenutils::BaseNDecoder<Codec> decoder(codec, true);
+    std::vector<uint8_t> decoded;
+    for (size_t i = 0; i < wrapped.size(); i += szChunk) {
+        auto bytes = decoder.update(std::string_view(wrapped).substr(i, szChunk));
+        decoded.insert(decoded.end(), bytes.begin(), bytes.end());
+    }
+    std::span<const uint8_t> tail;
+    bool bRetVal = decoder.finish(&tail);
+    decoded.insert(decoded.end(), tail.begin(), tail.end());
+
+    return (encoded == expected) && bRetVal && (decoded == buffer);
+}
+
+void test_basen_stream()
+{
+    bool match = true;
+    for (size_t szChunk : {1, 2, 3, 7, 64, 4096}) {
+        match = match && check_stream(basenutils::Base64Codec{}, szChunk);
+        match = match && check_stream(basenutils::Base32Codec{}, szChunk);
+        match = match && check_stream(basenutils::Base85Codec{}, szChunk);
+    }
+
+    // errors are reported at their stream offset, and data after the padding is rejected
+    basenutils::BaseNDecoder<basenutils::Base64Codec> decoder;
+    decoder.update("Zm9v");
+    decoder.update("Y*Fy");
+    match = match && !decoder.finish() && (decoder.result().szErrorOffset == 5);
+
+    decoder.update("Zg==");
+    decoder.update("Zg==");
+    match = match && !decoder.finish() && (decoder.result().eStatus == basenutils::BaseNStatus::InvalidPadding);
+
+    // the decoder restarts after finish()
+    auto bytes = decoder.update("Zm9vYmFy");
+    match = match && decoder.finish() && (std::string(bytes.begin(), bytes.end()) == "foobar");
+
+    // a Z85 stream which does not end on a whole group is reported, not silently cut
+    const uint8_t z85Input[] = {0x86, 0x4F, 0xD2, 0x6F, 0xB5, 0x59, 0xF7};
+    basenutils::BaseNEncoder<basenutils::Base85Codec> z85Encoder(basenutils::Base85Codec{basenutils::Base85Variant::Z85});
+    std::string encoded(z85Encoder.update(std::span<const uint8_t>(z85Input, 7)));
+    match = match && z85Encoder.finish().empty() && (encoded == "Hello") &&
+            (z85Encoder.result().eStatus == basenutils::BaseNStatus::InvalidLength) &&
+            (z85Encoder.result().szErrorOffset == 4) && (z85Encoder.result().szWritten == 5);
+
+    // the encoder restarts after finish()
+    encoded = z85Encoder.update(std::span<const uint8_t>(z85Input, 4));
+    match = match && z85Encoder.finish().empty() && z85Encoder.result() && (encoded == "Hello");
+
+    std::cout << "Test base-N stream: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+int main()
+{
+    test_base64_vectors();
+    test_base32_vectors();
+    test_base85_vectors();
+    test_basen_roundtrip();
+    test_base64_invalid();
+    test_basen_span();
+    test_basen_stream();
+    return 0;
+}
@@ -4,8 +4,8 @@
 
 int main(int argc, char* argv[])
 {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <filename>\n";
+    if ((argc != 2) && (argc != 3)) {
+        std::cerr << "Usage: " << argv[0] << " <filename> [<other filename>]\n";
         return 1;
     }
 
@@ -13,6 +13,11 @@ int main(int argc, char* argv[])
 
     viewer.show();
 
+    // Lines 10 to 14, through the line index, then the last 5 lines
+    viewer.buildLineIndex(false);
+    viewer.showLines(10, 5);
+    viewer.tail(5);
+
     // Show hex dump with various flag combinations
     viewer.showhex(16, "OSAD");
     viewer.showhex(16, "OSAd");
@@ -20,5 +25,16 @@ int main(int argc, char* argv[])
     viewer.showhex(16, "Osad");
     viewer.showhex(32, "osad");
 
+    // 64 bytes from offset 32, then the first two pages of 8 lines
+    viewer.showhex(16, "OSAD", 32, 1024, 64);
+    viewer.setPage(16, 8, "OSAD");
+    for (std::size_t page = 0; (page < 2) && viewer.page(page); ++page) {
+    }
+
+    // Side by side diff against a second file
+    if (argc == 3) {
+        viewer.showdiff(argv[2], 16, "OSAD");
+    }
+
     return 0;
 }
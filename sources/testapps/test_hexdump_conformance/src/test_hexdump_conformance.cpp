@@ -0,0 +1,584 @@
+
+#include "uHexdumpUtils.hpp"
+#include "uHexdumpLayout.hpp"
+#include "uFileViewer.hpp"
+#include "uArgsParser.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <unistd.h>
+
+namespace reference
+{
+
+// uFileViewer::m_HexDumpSection before the viewer moved to the shared renderer
+inline void FileViewerHexDump(const std::vector<char>& data, size_t szCrtOffset, size_t szBytesPerLine, bool bShowSpaces, bool bShowAscii, bool bShowOffset, bool bDecimalOffset, bool bColors)
+{
+    if (szBytesPerLine > 96) {
+        szBytesPerLine = 96;
+    }
+
+    size_t szOffset = szCrtOffset;
+    size_t szDataSize = data.size();
+    size_t szLines = szDataSize / szBytesPerLine;
+    size_t szLastLineLen = szDataSize % szBytesPerLine;
+
+    if (szLastLineLen != 0) ++szLines;
+
+    char buffer[96 * 3 + 1];
+
+    for (size_t i = 0; i < szLines; ++i) {
+        size_t szLineStart = i * szBytesPerLine;
+        size_t szLineLen = (i == szLines - 1 && szLastLineLen != 0) ? szLastLineLen : szBytesPerLine;
+
+        if (bShowOffset) {
+            if (bDecimalOffset) {
+                snprintf(buffer, sizeof(buffer), "%08zu | ", szOffset + szLineStart);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%08zX | ", szOffset + szLineStart);
+            }
+            std::printf(uFILEVIEWER_CFMT(bColors, uFILEVIEWER_OFFSET_COLOR, "%s"), buffer);
+        }
+
+        size_t pos = 0;
+        for (size_t j = 0; j < szBytesPerLine; ++j) {
+            if (j < szLineLen) {
+                pos += snprintf(buffer + pos, sizeof(buffer) - pos, bShowSpaces ? "%02X " : "%02X", static_cast<unsigned char>(data[szLineStart + j]));
+            } else {
+                pos += snprintf(buffer + pos, sizeof(buffer) - pos, bShowSpaces ? "   " : "  ");
+            }
+        }
+        std::printf(uFILEVIEWER_CFMT(bColors, uFILEVIEWER_HEX_COLOR, "%s"), buffer);
+
+        if (bShowAscii) {
+            pos = 0;
+            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " | ");
+            for (size_t j = 0; j < szLineLen; ++j) {
+                uint8_t ch = static_cast<unsigned char>(data[szLineStart + j]);
+                pos += snprintf(buffer + pos, sizeof(buffer) - pos, "%c", isprint(ch) ? ch : '.');
+            }
+            std::printf(uFILEVIEWER_CFMT(bColors, uFILEVIEWER_ASCII_COLOR, "%s"), buffer);
+        }
+
+        std::printf("\n");
+    }
+}
+
+} // namespace reference
+
+// Helper function to read back everything written to a temporary file
+static std::string read_file(std::FILE* pFile)
+{
+    std::string text;
+    std::fflush(pFile);
+    std::rewind(pFile);
+    char buffer[4096];
+    size_t len;
+    while ((len = std::fread(buffer, 1, sizeof(buffer), pFile)) > 0) {
+        text.append(buffer, len);
+    }
+    std::fclose(pFile);
+    return text;
+}
+
+// Helper function to capture everything fn writes to stdout, printf and fwrite alike
+template<typename Fn>
+static std::string capture_stdout(Fn&& fn)
+{
+    std::FILE* pFile = std::tmpfile();
+    std::fflush(stdout);
+    int savedFd = dup(fileno(stdout));
+    dup2(fileno(pFile), fileno(stdout));
+    fn();
+    std::fflush(stdout);
+    dup2(savedFd, fileno(stdout));
+    close(savedFd);
+    return read_file(pFile);
+}
+
+// Bytes with printable and non-printable runs, and zero runs for the squeezed dumps
+static std::vector<uint8_t> make_data(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = ((i / 256) % 3 == 1) ? 0 : static_cast<uint8_t>((i * 131 + 7) >> 1);
+    }
+    return data;
+}
+
+static const char* g_pstrViewerFile = "test_hexdump_conformance.bin";
+
+static void write_viewer_file(const std::vector<uint8_t>& data, size_t size)
+{
+    std::FILE* pFile = std::fopen(g_pstrViewerFile, "wb");
+    if (size > 0) {
+        std::fwrite(data.data(), 1, size, pFile);
+    }
+    std::fclose(pFile);
+}
+
+struct Case
+{
+    const uint8_t* pData;
+    size_t szSize;
+    size_t szBytesPerLine;
+    std::string strFlags;
+    hexutils::HexDumpOptions options;  // the flags applied, colors resolved
+};
+
+struct EntryPoint
+{
+    const char* pstrName;
+    std::function<std::string(const Case&)> fnDump;
+};
+
+// Every public way of producing a dump with the layout of the options
+static std::vector<EntryPoint> entry_points(hexutils::HexDumpStyle eStyle)
+{
+    std::vector<EntryPoint> entries = {
+        {"HexDumpBufferedS", [eStyle](const Case& c) {
+            return capture_stdout([&]() { hexutils::HexDumpBufferedS(c.pData, c.szSize, c.szBytesPerLine, c.strFlags, eStyle); });
+        }},
+        {"HexDumpBuffered", [](const Case& c) {
+            return capture_stdout([&]() { hexutils::HexDumpBuffered(c.pData, c.szSize, c.options); });
+        }},
+        {"HexDumpString", [](const Case& c) {
+            return hexutils::HexDumpString(c.pData, c.szSize, c.options);
+        }},
+        {"HexDumpToStream", [](const Case& c) {
+            std::ostringstream oss;
+            hexutils::HexDumpToStream(c.pData, c.szSize, oss, c.options);
+            return oss.str();
+        }},
+        {"HexDumpToFd", [](const Case& c) {
+            std::FILE* pFile = std::tmpfile();
+            hexutils::HexDumpToFd(c.pData, c.szSize, fileno(pFile), c.options);
+            return read_file(pFile);
+        }},
+        {"HexDumpLines", [](const Case& c) {
+            std::string text;
+            hexutils::HexDumpLines(c.pData, c.szSize, [&](std::string_view line) {
+                text.append(line);
+                text.push_back('\n');
+            }, c.options);
+            return text;
+        }},
+        {"HexDumpParallel", [](const Case& c) {
+            hexutils::HexDumpParallelOptions parallel;
+            parallel.uThreads = 3;
+            parallel.szBlockSize = 4096;
+            parallel.szThreshold = 0;
+            std::string text;
+            hexutils::HexDumpParallelTo(c.pData, c.szSize, [&](const char* pText, size_t szLen) {
+                text.append(pText, szLen);
+            }, c.options, parallel);
+            return text;
+        }},
+        {"HexDumpAnnotated", [](const Case& c) {
+            return hexutils::HexDumpAnnotatedString(c.pData, c.szSize, hexutils::HexDumpLayout{}, c.options);
+        }}};
+
+    if (hexutils::HexDumpStyle::PerByteColors == eStyle) {
+        entries.push_back({"HexDump1S", [](const Case& c) {
+            return capture_stdout([&]() { hexutils::HexDump1S(c.pData, c.szSize, c.szBytesPerLine, c.strFlags); });
+        }});
+    } else if (hexutils::HexDumpStyle::SectionColors == eStyle) {
+        entries.push_back({"HexDump2S", [](const Case& c) {
+            return capture_stdout([&]() { hexutils::HexDump2S(c.pData, c.szSize, c.szBytesPerLine, c.strFlags); });
+        }});
+    } else {
+        entries.push_back({"HexDump3S", [](const Case& c) {
+            return capture_stdout([&]() { hexutils::HexDump3S(c.pData, c.szSize, c.szBytesPerLine, c.strFlags); });
+        }});
+    }
+
+    return entries;
+}
+
+// Runs the entry points over all the cases; bColors selects HexDumpColor::Always or Never everywhere
+static bool check_style(hexutils::HexDumpStyle eStyle, bool bColors, const std::vector<uint8_t>& data)
+{
+    const hexutils::HexDumpColor eColor = bColors ? hexutils::HexDumpColor::Always : hexutils::HexDumpColor::Never;
+    hexutils::HexDumpSetColor(eColor);
+
+    std::vector<EntryPoint> entries = entry_points(eStyle);
+    std::vector<bool> results(entries.size(), true);
+
+    for (size_t szBytesPerLine : {1, 7, 16, 33, 96}) {
+        for (size_t szSize : {0, 1, 15, 16, 17, 1000, 20000}) {
+            for (const char* pstrFlags : {"", "s", "a", "o", "D", "SAOD", "saod", "Q", "sAoDQ"}) {
+                Case c{data.data(), szSize, szBytesPerLine, pstrFlags, {}};
+                c.options.szBytesPerLine = szBytesPerLine;
+                c.options.eStyle = eStyle;
+                c.options.eColor = eColor;
+                hexutils::HexDumpParseFlags(pstrFlags, c.options);
+
+                // the HexDump1/2 printf implementations are the reference of their style
+                std::string expected;
+                if (hexutils::HexDumpStyle::PerByteColors == eStyle) {
+                    expected = capture_stdout([&]() { hexutils::HexDump1S(c.pData, c.szSize, c.szBytesPerLine, c.strFlags); });
+                } else if (hexutils::HexDumpStyle::SectionColors == eStyle) {
+                    expected = capture_stdout([&]() { hexutils::HexDump2S(c.pData, c.szSize, c.szBytesPerLine, c.strFlags); });
+                } else {
+                    hexutils::HexDumpSetColor(hexutils::HexDumpColor::Never);
+                    expected = capture_stdout([&]() { hexutils::HexDump2S(c.pData, c.szSize, c.szBytesPerLine, c.strFlags); });
+                    hexutils::HexDumpSetColor(eColor);
+                }
+
+                for (size_t i = 0; i < entries.size(); ++i) {
+                    results[i] = results[i] && (entries[i].fnDump(c) == expected);
+                }
+            }
+        }
+    }
+
+    static const char* apstrStyles[] = {"PerByteColors", "SectionColors", "Plain"};
+    bool match = true;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        std::cout << "Conformance " << std::left << std::setw(18) << entries[i].pstrName << std::setw(14) << apstrStyles[static_cast<int>(eStyle)]
+                  << (bColors ? "colors   " : "no colors") << ": " << (results[i] ? "Passed" : "Failed") << std::endl;
+        match = match && results[i];
+    }
+
+    hexutils::HexDumpSetColor(hexutils::HexDumpColor::Auto);
+    return match;
+}
+
+// uFileViewer::showhex against its previous implementation, and against HexDump2 without colors
+static bool check_viewer(const std::vector<uint8_t>& data)
+{
+    bool match = true;
+
+    for (bool bColors : {false, true}) {
+        for (size_t szBytesPerLine : {1, 7, 16, 33, 96, 100}) {
+            for (size_t szSize : {0, 1, 17, 1000, 20000}) {
+                write_viewer_file(data, szSize);
+
+                for (const char* pstrFlags : {"", "s", "a", "o", "D", "SAOD", "saod", "Q", "sQ"}) {
+                    hexutils::HexDumpOptions options;
+                    hexutils::HexDumpParseFlags(pstrFlags, options);
+
+                    // the mapped file is dumped in one go
+                    std::string expected = capture_stdout([&]() {
+                        uFileViewer fileViewer(g_pstrViewerFile, true);
+                        fileViewer.setColors(bColors);
+                        fileViewer.showhex(szBytesPerLine, pstrFlags);
+                    });
+                    if (!options.bSqueeze) {
+                        match = match && (expected == capture_stdout([&]() {
+                            std::vector<char> whole(data.begin(), data.begin() + szSize);
+                            reference::FileViewerHexDump(whole, 0, szBytesPerLine, options.bShowSpaces, options.bShowAscii,
+                                                         options.bShowOffset, options.bDecimalOffset, bColors);
+                        }));
+                    }
+                    if (!bColors) {
+                        hexutils::HexDumpSetColor(hexutils::HexDumpColor::Never);
+                        match = match && (expected == capture_stdout([&]() { hexutils::HexDump2S(data.data(), szSize, szBytesPerLine, pstrFlags); }));
+                        hexutils::HexDumpSetColor(hexutils::HexDumpColor::Auto);
+                    }
+
+                    // any chunk size, whole lines or not, gives the same text
+                    for (size_t szChunkSize : {1, 100, 4096, 256 * 1024}) {
+                        std::string viewer = capture_stdout([&]() {
+                            uFileViewer fileViewer(g_pstrViewerFile);
+                            fileViewer.setColors(bColors);
+                            fileViewer.showhex(szBytesPerLine, pstrFlags, 0, szChunkSize);
+                        });
+                        match = match && (viewer == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    // ranges and pages: only the requested bytes, with offsets counted from the range or from the start of the file
+    write_viewer_file(data, data.size());
+    for (bool bMapped : {false, true}) {
+        for (const auto& [szOffset, szLength] : {std::pair<size_t, size_t>{0, 0}, {0, 256}, {5, 1}, {1000, 999}, {19990, 100}, {20000, 16}, {25000, 16}}) {
+            for (bool bAbsolute : {false, true}) {
+                std::string expected = capture_stdout([&]() {
+                    if (szOffset < data.size()) {
+                        std::vector<char> chunk(data.begin() + szOffset, data.begin() + std::min(szOffset + szLength, data.size()));
+                        reference::FileViewerHexDump(chunk, bAbsolute ? szOffset : 0, 16, true, true, true, false, false);
+                    }
+                });
+                std::string viewer = capture_stdout([&]() {
+                    uFileViewer fileViewer(g_pstrViewerFile, bMapped);
+                    fileViewer.setColors(false);
+                    fileViewer.showhex(16, "", szOffset, 1024, szLength, bAbsolute);
+                });
+                match = match && (viewer == expected);
+            }
+        }
+
+        // the pages joined are the whole dump, also past the 96 bytes per line of the viewer layout
+        for (size_t szBytesPerLine : {16, 200}) {
+            const size_t szPageSize = std::min<size_t>(szBytesPerLine, 96) * 24;
+            std::string pages = capture_stdout([&]() {
+                uFileViewer fileViewer(g_pstrViewerFile, bMapped);
+                fileViewer.setColors(false);
+                fileViewer.setPage(szBytesPerLine, 24, "SAOd");
+                match = match && (fileViewer.pageCount() == (data.size() + szPageSize - 1) / szPageSize);
+                for (size_t szPage = 0; fileViewer.page(szPage); ++szPage) {
+                }
+            });
+            std::string whole = capture_stdout([&]() {
+                uFileViewer fileViewer(g_pstrViewerFile, bMapped);
+                fileViewer.setColors(false);
+                fileViewer.showhex(szBytesPerLine, "SAOd", 0, szPageSize);
+            });
+            match = match && !pages.empty() && (pages == whole);
+        }
+    }
+
+    std::remove(g_pstrViewerFile);
+    std::cout << "Conformance " << std::left << std::setw(18) << "uFileViewer" << std::setw(14) << "SectionColors" << "both     : "
+              << (match ? "Passed" : "Failed") << std::endl;
+    return match;
+}
+
+// uFileViewer text views: show(), showLines() with and without the line index, tail()
+static bool check_viewer_text()
+{
+    bool match = true;
+
+    for (size_t szLines : {0, 3, 5000}) {
+        for (bool bFinalNewline : {true, false}) {
+            std::vector<std::string> lines;
+            std::string text;
+            for (size_t i = 0; i < szLines; ++i) {
+                lines.push_back("line " + std::to_string(i) + std::string(i % 7, 'x'));
+                text += lines.back() + "\n";
+            }
+            if (!bFinalNewline && !text.empty()) {
+                text.pop_back();
+            }
+            write_viewer_file(std::vector<uint8_t>(text.begin(), text.end()), text.size());
+            std::remove((std::string(g_pstrViewerFile) + uFILEVIEWER_LINE_INDEX_SUFFIX).c_str());
+
+            for (bool bMapped : {false, true}) {
+                for (bool bColors : {false, true}) {
+                    auto expected = [&](size_t szFrom, size_t szCount) {
+                        std::string strLines;
+                        for (size_t i = szFrom; i < std::min(szLines, szFrom + szCount); ++i) {
+                            strLines += bColors ? uFILEVIEWER_ASCII_COLOR + lines[i] + "\n" uFILEVIEWER_RESET_COLOR : lines[i] + "\n";
+                        }
+                        return strLines;
+                    };
+
+                    uFileViewer fileViewer(g_pstrViewerFile, bMapped);
+                    fileViewer.setColors(bColors);
+                    match = match && (capture_stdout([&]() { fileViewer.show(); }) == expected(0, szLines));
+
+                    // no index, an index built here and saved, the saved index loaded by another viewer
+                    uFileViewer cachedViewer(g_pstrViewerFile, bMapped);
+                    cachedViewer.setColors(bColors);
+                    for (int iPass = 0; iPass < 3; ++iPass) {
+                        uFileViewer& viewer = (2 == iPass) ? cachedViewer : fileViewer;
+                        if (0 != iPass) {
+                            match = match && (viewer.buildLineIndex(true) == szLines);
+                        }
+                        for (size_t szFrom : {0, 2, 1023, 1024, 1025, 4999, 6000}) {
+                            for (size_t szCount : {1, 3, 2000}) {
+                                match = match && (capture_stdout([&]() { viewer.showLines(szFrom, szCount); }) == expected(szFrom, szCount));
+                            }
+                        }
+                    }
+
+                    for (size_t szCount : {1, 3, 10, 5000, 6000}) {
+                        match = match && (capture_stdout([&]() { fileViewer.tail(szCount); }) == expected((szLines > szCount) ? szLines - szCount : 0, szCount));
+                    }
+                    match = match && (fileViewer.lineCount() == szLines);
+                }
+            }
+        }
+    }
+
+    // by default the index is not saved, and an index of a file changed since is not used
+    std::remove((std::string(g_pstrViewerFile) + uFILEVIEWER_LINE_INDEX_SUFFIX).c_str());
+    const std::string strOld = "a\nb\nc\n";
+    const std::string strNew = "first\nsecond\nthird\nfourth\n";
+    write_viewer_file(std::vector<uint8_t>(strOld.begin(), strOld.end()), strOld.size());
+    uFileViewer fileViewer(g_pstrViewerFile);
+    fileViewer.setColors(false);
+    match = match && (fileViewer.buildLineIndex() == 3) && !std::ifstream(std::string(g_pstrViewerFile) + uFILEVIEWER_LINE_INDEX_SUFFIX);
+    write_viewer_file(std::vector<uint8_t>(strNew.begin(), strNew.end()), strNew.size());
+    match = match && (capture_stdout([&]() { fileViewer.showLines(1, 2); }) == "second\nthird\n") && (fileViewer.lineCount() == 4);
+
+    std::remove((std::string(g_pstrViewerFile) + uFILEVIEWER_LINE_INDEX_SUFFIX).c_str());
+    std::remove(g_pstrViewerFile);
+    std::cout << "Conformance " << std::left << std::setw(18) << "uFileViewer" << std::setw(14) << "text" << "both     : "
+              << (match ? "Passed" : "Failed") << std::endl;
+    return match;
+}
+
+// uFileViewer follow modes: what is appended while following comes out as the dump of the whole file
+static bool check_viewer_follow(const std::vector<uint8_t>& data)
+{
+    bool match = true;
+
+    for (bool bMapped : {false, true}) {
+        for (bool bHex : {false, true}) {
+            write_viewer_file(data, 1000);
+            std::string followed = capture_stdout([&]() {
+                uFileViewer fileViewer(g_pstrViewerFile, bMapped);
+                fileViewer.setColors(false);
+                std::thread follower([&]() {
+                    if (bHex) {
+                        fileViewer.followHex(16, "", true);
+                    } else {
+                        fileViewer.followText(SIZE_MAX);
+                    }
+                });
+                std::FILE* pFile = std::fopen(g_pstrViewerFile, "ab");
+                for (size_t szOffset = 1000; szOffset < data.size(); szOffset += 1900) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                    std::fwrite(data.data() + szOffset, 1, std::min<size_t>(1900, data.size() - szOffset), pFile);
+                    std::fflush(pFile);
+                }
+                std::fclose(pFile);
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                fileViewer.stopFollow();
+                follower.join();
+            });
+            std::string whole = capture_stdout([&]() {
+                uFileViewer fileViewer(g_pstrViewerFile);
+                fileViewer.setColors(false);
+                if (bHex) {
+                    fileViewer.showhex(16);
+                } else {
+                    fileViewer.show();
+                }
+            });
+            match = match && (followed == whole);
+        }
+    }
+
+    // a viewer follows again after a stop; the stops requested in between do not end the next follow
+    write_viewer_file(data, 100);
+    uFileViewer fileViewer(g_pstrViewerFile);
+    fileViewer.setColors(false);
+    std::string shown = capture_stdout([&]() { fileViewer.showhex(16); });
+    for (int iRun = 0; iRun < 2; ++iRun) {
+        fileViewer.stopFollow();
+        std::atomic<bool> bDone{false};
+        std::string followed = capture_stdout([&]() {
+            std::thread follower([&]() {
+                fileViewer.followHex(16, "", true);
+                bDone.store(true);
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            match = match && !bDone.load();
+            fileViewer.stopFollow();
+            follower.join();
+        });
+        match = match && (followed == shown);
+    }
+
+    std::remove(g_pstrViewerFile);
+    std::cout << "Conformance " << std::left << std::setw(18) << "uFileViewer" << std::setw(14) << "follow" << "both     : "
+              << (match ? "Passed" : "Failed") << std::endl;
+    return match;
+}
+
+// Time of every entry point on a large buffer, the dumps going to /dev/null
+static void bench(size_t szSize)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<uint8_t> data = make_data(szSize);
+    write_viewer_file(data, szSize);
+
+    hexutils::HexDumpOptions options;
+    options.eStyle = hexutils::HexDumpStyle::SectionColors;
+    options.eColor = hexutils::HexDumpColor::Always;
+    hexutils::HexDumpSetColor(hexutils::HexDumpColor::Always);
+
+    const std::pair<const char*, std::function<void()>> entries[] = {
+        {"HexDump2S", [&]() { hexutils::HexDump2S(data.data(), szSize, 16, ""); }},
+        {"HexDumpBuffered", [&]() { hexutils::HexDumpBuffered(data.data(), szSize, options); }},
+        {"HexDumpString", [&]() {
+            std::string text = hexutils::HexDumpString(data.data(), szSize, options);
+            std::fwrite(text.data(), 1, text.size(), stdout);
+        }},
+        {"HexDumpToFd", [&]() { hexutils::HexDumpToFd(data.data(), szSize, fileno(stdout), options); }},
+        {"HexDumpParallel", [&]() { hexutils::HexDumpParallel(data.data(), szSize, options); }},
+        {"HexDumpAnnotated", [&]() { hexutils::HexDumpAnnotated(data.data(), szSize, hexutils::HexDumpLayout{}, options); }},
+        {"uFileViewer", [&]() {
+            uFileViewer fileViewer(g_pstrViewerFile);
+            fileViewer.setColors(true);
+            fileViewer.showhex(16);
+        }},
+        {"uFileViewer mapped", [&]() {
+            uFileViewer fileViewer(g_pstrViewerFile, true);
+            fileViewer.setColors(true);
+            fileViewer.showhex(16);
+        }}};
+
+    std::FILE* pNull = std::fopen("/dev/null", "w");
+    std::fflush(stdout);
+    int savedFd = dup(fileno(stdout));
+    dup2(fileno(pNull), fileno(stdout));
+
+    std::vector<double> seconds;
+    for (const auto& [pstrName, fnDump] : entries) {
+        auto start = Clock::now();
+        fnDump();
+        std::fflush(stdout);
+        seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    dup2(savedFd, fileno(stdout));
+    close(savedFd);
+    std::fclose(pNull);
+    std::remove(g_pstrViewerFile);
+    hexutils::HexDumpSetColor(hexutils::HexDumpColor::Auto);
+
+    std::cout << std::endl << "Benchmark, " << szSize << " bytes, HexDump2 layout with colors" << std::endl;
+    for (size_t i = 0; i < seconds.size(); ++i) {
+        std::cout << std::left << std::setw(20) << entries[i].first << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << seconds[i] * 1e3 << " ms" << std::setw(10) << static_cast<double>(szSize) / 1e6 / seconds[i] << " MB/s" << std::endl;
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    CommandLineParser cli("Checks every hexdump entry point, uFileViewer included, gives the same text");
+    cli.add_option("bench", "Also time every entry point on a buffer of the given size in MB (default 16)");
+    cli.add_option("help", "Show this help");
+    cli.parse(argc, argv);
+
+    if (cli.has("help")) {
+        cli.print_usage();
+        return 0;
+    }
+
+    std::vector<uint8_t> data = make_data(20000);
+    bool match = true;
+    for (hexutils::HexDumpStyle eStyle : {hexutils::HexDumpStyle::PerByteColors, hexutils::HexDumpStyle::SectionColors, hexutils::HexDumpStyle::Plain}) {
+        for (bool bColors : {false, true}) {
+            match = check_style(eStyle, bColors, data) && match;
+        }
+    }
+    match = check_viewer(data) && match;
+    match = check_viewer_text() && match;
+    match = check_viewer_follow(data) && match;
+
+    std::cout << "Hexdump conformance Test " << (match ? "Passed" : "Failed") << std::endl;
+
+    if (cli.has("bench")) {
+        bench(static_cast<size_t>(std::stoull(cli.get("bench").value_or("16"))) << 20);
+    }
+
+    return match ? 0 : 1;
+}
@@ -1,11 +1,18 @@
 
 #include "uHexdumpUtils.hpp"
+#include "uHexdumpLayout.hpp"
+#include "uHexdumpDiff.hpp"
+#include "uHexdumpReverse.hpp"
 #include <iostream>
 #include <vector>
 #include <string>
 #include <sstream>
 #include <iomanip>
 #include <cstring>
+#include <algorithm>
+#include <cstdio>
+#include <unistd.h>
+#include <memory_resource>
 
 // Helper function to generate test data
 std::vector<uint8_t> generate_test_data(size_t size)
@@ -27,6 +34,57 @@ std::string capture_stdout(void (*func)(const uint8_t*, size_t, size_t, bool, bo
     return oss.str();
 }
 
+// Helper function to read back everything written to a temporary file
+static std::string read_file(std::FILE* pFile)
+{
+    std::string text;
+    std::fflush(pFile);
+    std::rewind(pFile);
+    char buffer[4096];
+    size_t len;
+    while ((len = std::fread(buffer, 1, sizeof(buffer), pFile)) > 0) {
+        text.append(buffer, len);
+    }
+    std::fclose(pFile);
+    return text;
+}
+
+// Helper function to capture the printf output of a dump at the file descriptor level
+std::string capture_stdio(void (*func)(const uint8_t*, size_t, size_t, bool, bool, bool, bool), const uint8_t* data, size_t dataSize, size_t bytesPerLine, bool showSpaces, bool showAscii, bool showOffset, bool decimalOffset)
+{
+    std::FILE* pFile = std::tmpfile();
+    std::fflush(stdout);
+    int savedFd = dup(fileno(stdout));
+    dup2(fileno(pFile), fileno(stdout));
+    func(data, dataSize, bytesPerLine, showSpaces, showAscii, showOffset, decimalOffset);
+    std::fflush(stdout);
+    dup2(savedFd, fileno(stdout));
+    close(savedFd);
+    return read_file(pFile);
+}
+
+// Helper function to capture the printf output of a flag string dump at the file descriptor level
+std::string capture_stdio_flags(void (*func)(const uint8_t*, size_t, size_t, const std::string&), const uint8_t* data, size_t dataSize, size_t bytesPerLine, const std::string& flags)
+{
+    std::FILE* pFile = std::tmpfile();
+    std::fflush(stdout);
+    int savedFd = dup(fileno(stdout));
+    dup2(fileno(pFile), fileno(stdout));
+    func(data, dataSize, bytesPerLine, flags);
+    std::fflush(stdout);
+    dup2(savedFd, fileno(stdout));
+    close(savedFd);
+    return read_file(pFile);
+}
+
+// Helper function to capture the output of the buffered renderer
+std::string capture_buffered(const uint8_t* data, size_t dataSize, const hexutils::HexDumpOptions& options)
+{
+    std::FILE* pFile = std::tmpfile();
+    hexutils::HexDumpBuffered(data, dataSize, options, pFile);
+    return read_file(pFile);
+}
+
 // Test HexDump1 with direct parameters
 void test_HexDump1_direct()
 {
@@ -126,6 +184,605 @@ void test_HexDump3_flag()
     std::cout << "HexDump3S (flag) Test Passed\n";
 }
 
+// Test the buffered renderer is byte-identical to HexDump1/2/3
+void test_HexDumpBuffered_conformance()
+{
+    struct Legacy {
+        void (*func)(const uint8_t*, size_t, size_t, bool, bool, bool, bool);
+        hexutils::HexDumpStyle style;
+    };
+    const Legacy legacy[] = {
+        {hexutils::HexDump1, hexutils::HexDumpStyle::PerByteColors},
+        {hexutils::HexDump2, hexutils::HexDumpStyle::SectionColors},
+        {hexutils::HexDump3, hexutils::HexDumpStyle::Plain}};
+
+    std::vector<uint8_t> data = generate_test_data(300);
+    bool match = true;
+    for (hexutils::HexDumpColor color : {hexutils::HexDumpColor::Always, hexutils::HexDumpColor::Auto}) {
+        hexutils::HexDumpSetColor(color);
+        for (const Legacy& variant : legacy) {
+            for (size_t bytesPerLine : {1, 7, 16, 33, 96, 100}) {
+                for (size_t dataSize : {0, 1, 15, 16, 17, 300}) {
+                    for (unsigned flags = 0; flags < 16; ++flags) {
+                        hexutils::HexDumpOptions options;
+                        options.szBytesPerLine = bytesPerLine;
+                        options.bShowSpaces = flags & 1;
+                        options.bShowAscii = flags & 2;
+                        options.bShowOffset = flags & 4;
+                        options.bDecimalOffset = flags & 8;
+                        options.eStyle = variant.style;
+                        options.eColor = color;
+                        std::string expected = capture_stdio(variant.func, data.data(), dataSize, bytesPerLine,
+                                                             options.bShowSpaces, options.bShowAscii, options.bShowOffset, options.bDecimalOffset);
+                        match = match && (expected == capture_buffered(data.data(), dataSize, options));
+                    }
+                }
+            }
+        }
+    }
+
+    // large dumps span several flushed blocks
+    hexutils::HexDumpSetColor(hexutils::HexDumpColor::Always);
+    std::vector<uint8_t> large = generate_test_data(100000);
+    hexutils::HexDumpOptions options;
+    options.eColor = hexutils::HexDumpColor::Always;
+    std::string expected = capture_stdio(hexutils::HexDump1, large.data(), large.size(), 16, true, true, true, false);
+    match = match && (expected == capture_buffered(large.data(), large.size(), options));
+
+    hexutils::HexDumpSetColor(hexutils::HexDumpColor::Auto);
+
+    std::cout << "HexDumpBuffered (conformance) Test " << (match ? "Passed" : "Failed") << "\n";
+}
+
+// Test every column kernel the CPU supports against a plain per-byte formatting
+void test_HexDump_column_kernels()
+{
+    std::vector<hexutils::internal::HexDumpKernels> kernels = {hexutils::internal::hexdump_kernels()};
+#if defined(uHEXDUMP_SIMD_X86)
+    if (__builtin_cpu_supports("ssse3")) {
+        kernels.push_back({hexutils::internal::hexdump_hex_ssse3, hexutils::internal::hexdump_hex_spaced_ssse3, hexutils::internal::hexdump_ascii_ssse3});
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({hexutils::internal::hexdump_hex_avx2, hexutils::internal::hexdump_hex_spaced_avx2, hexutils::internal::hexdump_ascii_avx2});
+    }
+#endif
+
+    std::vector<uint8_t> data(96);
+    bool match = true;
+    for (size_t base = 0; base < 256; base += 96) {
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<uint8_t>((base + i * 7) % 256);
+        }
+        for (const auto& kernel : kernels) {
+            for (size_t len = 0; len <= data.size(); ++len) {
+                std::string hex(2 * len, '?'), spaced(3 * len, '?'), ascii(len, '?');
+                std::string expectedHex, expectedSpaced, expectedAscii;
+                for (size_t i = 0; i < len; ++i) {
+                    char cell[4];
+                    snprintf(cell, sizeof(cell), "%02X", data[i]);
+                    expectedHex += cell;
+                    expectedSpaced += std::string(cell) + " ";
+                    expectedAscii += isprint(data[i]) ? static_cast<char>(data[i]) : '.';
+                }
+                size_t doneHex = kernel.pfnHex(data.data(), len, hex.data());
+                size_t doneSpaced = kernel.pfnHexSpaced(data.data(), len, spaced.data());
+                size_t doneAscii = kernel.pfnAscii(data.data(), len, ascii.data());
+                match = match && (doneHex <= len) && (0 == hex.compare(0, 2 * doneHex, expectedHex, 0, 2 * doneHex));
+                match = match && (doneSpaced <= len) && (0 == spaced.compare(0, 3 * doneSpaced, expectedSpaced, 0, 3 * doneSpaced));
+                match = match && (doneAscii <= len) && (0 == ascii.compare(0, doneAscii, expectedAscii, 0, doneAscii));
+            }
+        }
+    }
+
+    std::cout << "HexDump column kernels Test " << (match ? "Passed" : "Failed") << "\n";
+}
+
+// Test every sink receives the same text as the FILE output, and HexDump3 keeps its layout
+void test_HexDump_sinks()
+{
+    std::vector<uint8_t> data = generate_test_data(100000);
+    hexutils::HexDumpOptions options;
+    options.eStyle = hexutils::HexDumpStyle::Plain;
+    options.szBaseOffset = 0x100;
+    std::string expected = capture_buffered(data.data(), data.size(), options);
+
+    std::string str = "prefix\n";
+    hexutils::HexDumpToString(data.data(), data.size(), str, options);
+    bool match = (str == "prefix\n" + expected);
+
+    std::pmr::monotonic_buffer_resource resource;
+    std::pmr::string pmrStr(&resource);
+    hexutils::HexDumpToString(data.data(), data.size(), pmrStr, options);
+    match = match && (std::string_view(pmrStr) == expected);
+
+    std::ostringstream oss;
+    hexutils::HexDumpToStream(data.data(), data.size(), oss, options);
+    match = match && (oss.str() == expected);
+
+    std::FILE* pFile = std::tmpfile();
+    match = match && hexutils::HexDumpToFd(data.data(), data.size(), fileno(pFile), options);
+    match = match && (read_file(pFile) == expected);
+    match = match && !hexutils::HexDumpToFd(data.data(), data.size(), -1, options);
+    hexutils::HexDumpFdSink badSink(-1);
+    badSink("text", 4);
+    match = match && !badSink.ok() && (badSink.error() == EBADF);
+
+    std::string lines;
+    size_t lineCount = 0;
+    hexutils::HexDumpLines(data.data(), data.size(), [&](std::string_view line) {
+        lines.append(line);
+        lines.push_back('\n');
+        ++lineCount;
+    }, options);
+    match = match && (lines == expected) && (lineCount == (data.size() + 15) / 16);
+
+    std::string blocks;
+    size_t blockCount = 0;
+    hexutils::HexDumpTo(data.data(), data.size(), [&](const char* text, size_t len) {
+        blocks.append(text, len);
+        ++blockCount;
+    }, options);
+    match = match && (blocks == expected) && (blockCount > 1) && (blockCount < lineCount / 100);
+
+    // HexDump3 layout, independently of the renderer
+    const uint8_t sample[] = {'H', 'i', 0x00, 0x7F, 0xFF};
+    options = {};
+    options.szBytesPerLine = 4;
+    options.eStyle = hexutils::HexDumpStyle::Plain;
+    match = match && (hexutils::HexDumpString(sample, sizeof(sample), options) ==
+                      "00000000 | 48 69 00 7F  | Hi..\n"
+                      "00000004 | FF           | .\n");
+    options.bShowSpaces = false;
+    options.bDecimalOffset = true;
+    options.szBaseOffset = 96;
+    match = match && (hexutils::HexDumpString(sample, sizeof(sample), options) ==
+                      "00000096 | 4869007F | Hi..\n"
+                      "00000100 | FF       | .\n");
+
+    // colors: Auto never colors a string or a file, Always does, whatever the destination
+    options = {};
+    std::string autoText = hexutils::HexDumpString(sample, sizeof(sample), options);
+    options.eColor = hexutils::HexDumpColor::Always;
+    std::string colorText = hexutils::HexDumpString(sample, sizeof(sample), options);
+    options.eColor = hexutils::HexDumpColor::Never;
+    options.eStyle = hexutils::HexDumpStyle::SectionColors;
+    std::string neverText = hexutils::HexDumpString(sample, sizeof(sample), options);
+    match = match && (autoText.find('\033') == std::string::npos) && (autoText == neverText);
+    match = match && (colorText.find(uHEXDUMP_HEX_COLOR "48 " uHEXDUMP_RESET_COLOR) != std::string::npos);
+    match = match && (capture_buffered(sample, sizeof(sample), {}) == autoText);
+
+    std::cout << "HexDump sinks Test " << (match ? "Passed" : "Failed") << "\n";
+}
+
+// Test the parallel dump emits the same text as the serial one, in order
+void test_HexDumpParallel()
+{
+    std::vector<uint8_t> data = generate_test_data(200003);
+    bool match = true;
+
+    for (hexutils::HexDumpStyle style : {hexutils::HexDumpStyle::PerByteColors, hexutils::HexDumpStyle::SectionColors}) {
+        hexutils::HexDumpOptions options;
+        options.eStyle = style;
+        options.eColor = hexutils::HexDumpColor::Always;
+        options.szBytesPerLine = 100;
+        options.szBaseOffset = 0x1000;
+        std::string expected = hexutils::HexDumpString(data.data(), data.size(), options);
+
+        for (unsigned threads : {1, 2, 4}) {
+            for (size_t window : {1, 3, 0}) {
+                for (size_t blockSize : {1, 1000, 65536}) {
+                    hexutils::HexDumpParallelOptions parallel;
+                    parallel.uThreads = threads;
+                    parallel.szMaxBufferedBlocks = window;
+                    parallel.szBlockSize = blockSize;
+                    parallel.szThreshold = 0;
+
+                    std::string text;
+                    hexutils::HexDumpParallelTo(data.data(), data.size(), [&](const char* block, size_t len) {
+                        text.append(block, len);
+                    }, options, parallel);
+                    match = match && (text == expected);
+                }
+            }
+        }
+    }
+
+    // an exception thrown by the sink stops the workers and reaches the caller
+    hexutils::HexDumpParallelOptions parallel;
+    parallel.uThreads = 4;
+    parallel.szBlockSize = 1024;
+    parallel.szThreshold = 0;
+    size_t blocks = 0;
+    bool thrown = false;
+    try {
+        hexutils::HexDumpParallelTo(data.data(), data.size(), [&](const char*, size_t) {
+            if (++blocks == 3) {
+                throw std::runtime_error("sink full");
+            }
+        }, {}, parallel);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    match = match && thrown && (blocks == 3);
+
+    // FILE output
+    hexutils::HexDumpOptions options;
+    std::FILE* pFile = std::tmpfile();
+    hexutils::HexDumpParallel(data.data(), data.size(), options, parallel, pFile);
+    match = match && (read_file(pFile) == capture_buffered(data.data(), data.size(), options));
+
+    std::cout << "HexDumpParallel Test " << (match ? "Passed" : "Failed") << "\n";
+}
+
+// Test runs of identical lines collapse into one "*" line, the same way in every output path
+void test_HexDump_squeeze()
+{
+    // zero runs of various lengths between distinct lines, and a short repeated tail
+    std::vector<uint8_t> data(1000, 0);
+    for (size_t pos : {0, 40, 48, 200, 500, 992}) {
+        data[pos] = static_cast<uint8_t>(pos + 1);
+    }
+
+    const struct {
+        void (*func)(const uint8_t*, size_t, size_t, const std::string&);
+        hexutils::HexDumpStyle style;
+    } legacy[] = {
+        {hexutils::HexDump1S, hexutils::HexDumpStyle::PerByteColors},
+        {hexutils::HexDump2S, hexutils::HexDumpStyle::SectionColors},
+        {hexutils::HexDump3S, hexutils::HexDumpStyle::Plain}};
+
+    bool match = true;
+    hexutils::HexDumpSetColor(hexutils::HexDumpColor::Always);
+    for (const auto& variant : legacy) {
+        for (size_t bytesPerLine : {1, 8, 16, 33}) {
+            for (size_t dataSize : {0, 16, 17, 64, 1000}) {
+                hexutils::HexDumpOptions options;
+                options.szBytesPerLine = bytesPerLine;
+                options.bSqueeze = true;
+                options.eStyle = variant.style;
+                options.eColor = hexutils::HexDumpColor::Always;
+                std::string expected = capture_stdio_flags(variant.func, data.data(), dataSize, bytesPerLine, "Q");
+                match = match && (expected == capture_buffered(data.data(), dataSize, options));
+            }
+        }
+    }
+    hexutils::HexDumpSetColor(hexutils::HexDumpColor::Auto);
+
+    // like hexdump -C: the last line is always shown, the "*" stands for the lines it replaces
+    hexutils::HexDumpOptions options;
+    options.szBytesPerLine = 4;
+    options.bShowAscii = false;
+    options.bSqueeze = true;
+    options.eStyle = hexutils::HexDumpStyle::Plain;
+    const uint8_t sample[] = {1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    std::string squeezed = hexutils::HexDumpString(sample, sizeof(sample), options);
+    match = match && (squeezed == "00000000 | 01 02 03 04 \n"
+                                  "00000004 | 00 00 00 00 \n"
+                                  "*\n"
+                                  "00000014 | 00 00       \n");
+
+    std::string lines;
+    hexutils::HexDumpLines(sample, sizeof(sample), [&](std::string_view line) {
+        lines.append(line);
+        lines.push_back('\n');
+    }, options);
+    match = match && (lines == squeezed);
+    match = match && (hexutils::HexDumpString(sample, 20, options) == "00000000 | 01 02 03 04 \n"
+                                                                        "00000004 | 00 00 00 00 \n"
+                                                                        "*\n"
+                                                                        "00000010 | 00 00 00 00 \n");
+
+    // parallel blocks split inside a run still print a single "*"
+    options = {};
+    options.bSqueeze = true;
+    std::vector<uint8_t> large(300000, 0);
+    for (size_t pos = 0; pos < large.size(); pos += 7777) {
+        large[pos] = 0xAA;
+    }
+    std::string expected = hexutils::HexDumpString(large.data(), large.size(), options);
+    for (size_t blockSize : {16, 1000, 65536}) {
+        hexutils::HexDumpParallelOptions parallel;
+        parallel.uThreads = 3;
+        parallel.szBlockSize = blockSize;
+        parallel.szThreshold = 0;
+        std::string text;
+        hexutils::HexDumpParallelTo(large.data(), large.size(), [&](const char* block, size_t len) {
+            text.append(block, len);
+        }, options, parallel);
+        match = match && (text == expected);
+    }
+    options.bSqueeze = false;
+    match = match && (expected.size() * 4 < hexutils::HexDumpString(large.data(), large.size(), options).size());
+
+    std::cout << "HexDump squeeze Test " << (match ? "Passed" : "Failed") << "\n";
+}
+
+// Test the annotated dump decodes the fields of a layout read from an INI section
+void test_HexDumpAnnotated()
+{
+    const char* iniPath = "test_hexdump_layout.ini";
+    std::FILE* pIni = std::fopen(iniPath, "w");
+    std::fputs("[frame]\n"
+               "sync    = 0, x16, be\n"
+               "length  = 2, u16, be\n"
+               "payload = 4, 8, bytes\n"
+               "crc     = 0x0C, u32\n"
+               "name    = 16, 2, str\n"
+               "delta   = 18, 2, i, le\n"
+               "ratio   = 20, f32\n"
+               "missing = 22, u32\n"
+               "[broken]\n"
+               "size    = 0, 3, f\n", pIni);
+    std::fclose(pIni);
+
+    IniParser ini;
+    hexutils::HexDumpLayout layout;
+    bool match = ini.load(iniPath) && layout.load(ini, "frame") && (layout.fields().size() == 8);
+    std::remove(iniPath);
+
+    hexutils::HexDumpLayout broken;
+    match = match && !broken.load(ini, "broken") && !broken.load(ini, "none");
+    for (const char* spec : {"", "1", "x, u8", "0, u9", "0, 2, u8", "0, 9, u", "0, u8, me", "0, u8, le, be"}) {
+        match = match && !broken.add("field", spec);
+    }
+    match = match && broken.add("field", " 0x10 , 3 , x , be ") && (broken.fields().front().szOffset == 16) &&
+            (broken.fields().front().szLength == 3) && (broken.fields().front().eEndian == hexutils::Endianness::Big);
+
+    const uint8_t frame[] = {0xA5, 0x5A, 0x00, 0x08, 'H', 'e', 'l', 'l', 'o', '!', 0x00, 0x00, 0x78, 0x56, 0x34, 0x12,
+                             'O', 'K', 0xFE, 0xFF, 0x00, 0x00, 0xC0, 0x3F};
+    hexutils::HexDumpOptions options;
+    options.szBytesPerLine = 10;
+    options.eStyle = hexutils::HexDumpStyle::Plain;
+
+    // the annotations follow the raw dump lines, padded to the width of a full line
+    std::string raw = hexutils::HexDumpString(frame, sizeof(frame), options);
+    std::vector<std::string> lines;
+    for (size_t pos = 0; pos < raw.size(); pos = raw.find('\n', pos) + 1) {
+        lines.push_back(raw.substr(pos, raw.find('\n', pos) - pos));
+    }
+    std::string expected = lines[0] + "  sync=0xA55A  length=8  payload=48656C6C6F210000\n" +
+                           lines[1] + "  crc=305419896  name=OK  delta=-2\n" +
+                           lines[2] + std::string(lines[0].size() - lines[2].size(), ' ') + "  ratio=1.5  missing=??\n";
+    match = match && (lines.size() == 3) && (hexutils::HexDumpAnnotatedString(frame, sizeof(frame), layout, options) == expected);
+
+    std::FILE* pFile = std::tmpfile();
+    hexutils::HexDumpAnnotated(frame, sizeof(frame), layout, options, pFile);
+    match = match && (read_file(pFile) == expected);
+
+    // lines past the layout and without fields are the raw dump, squeezed lines included
+    std::vector<uint8_t> large(100000, 0);
+    std::memcpy(large.data(), frame, sizeof(frame));
+    options = {};
+    options.bSqueeze = true;
+    std::string annotated = hexutils::HexDumpAnnotatedString(large.data(), large.size(), layout, options);
+    std::string plain = hexutils::HexDumpString(large.data(), large.size(), options);
+    match = match && (annotated.substr(annotated.find("\n00000020")) == plain.substr(plain.find("\n00000020")));
+
+    // the base offset only changes the displayed offsets, the fields stay relative to the buffer
+    options = {};
+    options.szBytesPerLine = 10;
+    options.eStyle = hexutils::HexDumpStyle::Plain;
+    options.szBaseOffset = 0x1000;
+    raw = hexutils::HexDumpString(frame, sizeof(frame), options);
+    annotated = hexutils::HexDumpAnnotatedString(frame, sizeof(frame), layout, options);
+    match = match && (raw.compare(0, 9, "00001000 ") == 0) && (annotated.compare(0, lines[0].size(), raw, 0, lines[0].size()) == 0) &&
+            (annotated.find("  crc=305419896") != std::string::npos);
+
+    // in the colored styles the annotations line up too, a short last line included
+    for (hexutils::HexDumpStyle style : {hexutils::HexDumpStyle::PerByteColors, hexutils::HexDumpStyle::SectionColors}) {
+        options = {};
+        options.szBytesPerLine = 10;
+        options.eStyle = style;
+        options.eColor = hexutils::HexDumpColor::Always;
+        std::string colored = hexutils::HexDumpAnnotatedString(frame, sizeof(frame), layout, options);
+        std::string visible;
+        for (size_t pos = 0; pos < colored.size(); ++pos) {
+            if ('\033' == colored[pos]) {
+                pos = colored.find('m', pos);
+            } else {
+                visible.push_back(colored[pos]);
+            }
+        }
+        match = match && (visible.find("  sync=") == visible.find("  crc=") - visible.find('\n') - 1) &&
+                (visible.find("  sync=") == visible.find("  ratio=") - visible.find('\n', visible.find('\n') + 1) - 1);
+    }
+    options = {};
+    options.szBytesPerLine = 10;
+    options.eStyle = hexutils::HexDumpStyle::Plain;
+    options.szBaseOffset = 0x1000;
+
+    // a field far past the data costs nothing
+    hexutils::HexDumpLayout far;
+    match = match && far.add("far", "0x10000000000, u32") && far.add("sync", "0, x16, be");
+    annotated = hexutils::HexDumpAnnotatedString(frame, sizeof(frame), far, options);
+    match = match && (annotated.find("  sync=0xA55A\n") != std::string::npos) && (annotated.find("far=") == std::string::npos);
+
+    std::cout << "HexDump annotated Test " << (match ? "Passed" : "Failed") << "\n";
+}
+
+void test_HexDiff()
+{
+    const uint8_t a[] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', '1', '2', '3', '4', '5', '6', '7', '8'};
+    const uint8_t b[] = {'A', 'B', 'C', 'x', 'E', 'F', 'G', 'H', '1', '2', '3', '4', '5', '6', '7', '8', 'z', 'z'};
+    hexutils::HexDumpOptions options;
+    options.szBytesPerLine = 8;
+    options.eColor = hexutils::HexDumpColor::Never;
+
+    // identical lines are skipped, the differing bytes are marked on the line below
+    std::string marker0(81, ' ');
+    marker0[20] = marker0[21] = marker0[41] = marker0[59] = marker0[60] = marker0[80] = '^';
+    std::string marker2(79, ' ');
+    marker2[50] = marker2[51] = marker2[53] = marker2[54] = marker2[77] = marker2[78] = '^';
+    std::string expected = "00000000 | 41 42 43 44 45 46 47 48  | ABCDEFGH || 41 42 43 78 45 46 47 48  | ABCxEFGH\n" + marker0 + "\n" +
+                           "00000010 | " + std::string(24, ' ') + " | " + std::string(8, ' ') + " || 7A 7A " + std::string(18, ' ') + " | zz\n" + marker2 + "\n";
+
+    std::string out;
+    hexutils::HexDiffStats stats = hexutils::HexDiffTo(a, sizeof(a), b, sizeof(b), hexutils::HexDumpStringSink(out), options);
+    bool match = (out == expected) && (stats.szDiffBytes == 3) && (stats.szRegions == 2) && (stats.szDiffLines == 2) &&
+                 (stats.szFirstDiff == 3) && (stats.szCompared == 18) && !stats.identical();
+
+    std::FILE* pFile = std::tmpfile();
+    hexutils::HexDiff(a, sizeof(a), b, sizeof(b), options, pFile);
+    match = match && (read_file(pFile) == expected);
+
+    // colored: the differing bytes are highlighted in place, no marker lines
+    options.eColor = hexutils::HexDumpColor::Always;
+    out.clear();
+    stats = hexutils::HexDiffTo(a, sizeof(a), b, sizeof(b), hexutils::HexDumpStringSink(out), options);
+    match = match && (stats.szDiffBytes == 3) && (std::count(out.begin(), out.end(), '\n') == 2) &&
+            (out.find(uHEXDUMP_DIFF_COLOR "78") != std::string::npos) && (out.find('^') == std::string::npos);
+
+    // fed in chunks of whole lines, same output and statistics as in one go, regions spanning chunks included
+    std::vector<uint8_t> left(100000);
+    for (size_t i = 0; i < left.size(); ++i) {
+        left[i] = static_cast<uint8_t>((0x9E3779B97F4A7C15ULL * (i + 1)) >> 56);
+    }
+    std::vector<uint8_t> right(left.begin(), left.end() - 5);
+    for (size_t pos : {0, 100, 4095, 4096, 4097, 50000, 99990}) {
+        right[pos] ^= 0x40;
+    }
+    options = {};
+    std::string whole;
+    stats = hexutils::HexDiffTo(left.data(), left.size(), right.data(), right.size(), hexutils::HexDumpStringSink(whole), options);
+    match = match && (stats.szDiffBytes == 7 + 5) && (stats.szRegions == 6) && (stats.szFirstDiff == 0) && (stats.szDiffLines == 6);
+
+    hexutils::HexDiffer differ(options);
+    std::string chunked;
+    for (size_t pos = 0; pos < left.size(); pos += 4096) {
+        differ.update(left.data() + pos, std::min<size_t>(4096, left.size() - pos),
+                      right.data() + pos, (pos < right.size()) ? std::min<size_t>(4096, right.size() - pos) : 0,
+                      hexutils::HexDumpStringSink(chunked));
+    }
+    match = match && (chunked == whole) && (differ.stats().szDiffBytes == stats.szDiffBytes) &&
+            (differ.stats().szRegions == stats.szRegions) && (differ.stats().szCompared == left.size());
+
+    out.clear();
+    stats = hexutils::HexDiffTo(left.data(), left.size(), left.data(), left.size(), hexutils::HexDumpStringSink(out), options);
+    match = match && out.empty() && stats.identical() && (stats.szFirstDiff == SIZE_MAX);
+
+    // every mismatch kernel finds the same first difference
+    std::vector<hexutils::internal::HexDiffMismatchFn> kernels = {hexutils::internal::hexdiff_mismatch_scalar};
+#if defined(uHEXDUMP_SIMD_X86)
+    kernels.push_back(hexutils::internal::hexdiff_mismatch_sse2);
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back(hexutils::internal::hexdiff_mismatch_avx2);
+    }
+#elif defined(uHEXDUMP_SIMD_NEON)
+    kernels.push_back(hexutils::internal::hexdiff_mismatch_neon);
+#endif
+    std::vector<uint8_t> copy(left.begin(), left.begin() + 1000);
+    for (size_t len : {0, 1, 7, 8, 31, 64, 127, 128, 129, 1000}) {
+        for (size_t pos = 0; pos <= len; ++pos) {
+            if (pos < len) {
+                copy[pos] ^= 0x01;
+            }
+            for (auto pfnMismatch : kernels) {
+                match = match && (pfnMismatch(left.data(), copy.data(), len) == pos);
+            }
+            if (pos < len) {
+                copy[pos] ^= 0x01;
+            }
+        }
+    }
+
+    std::cout << "HexDiff Test " << (match ? "Passed" : "Failed") << "\n";
+}
+
+// Test the reverse dump rebuilds the bytes of every dump layout
+void test_HexDumpReverse()
+{
+    // runs of repeated lines for the squeezed dumps
+    std::vector<uint8_t> data = generate_test_data(1000);
+    std::fill(data.begin() + 100, data.begin() + 400, 0);
+
+    bool match = true;
+    for (hexutils::HexDumpStyle style : {hexutils::HexDumpStyle::PerByteColors, hexutils::HexDumpStyle::SectionColors, hexutils::HexDumpStyle::Plain}) {
+        for (hexutils::HexDumpColor color : {hexutils::HexDumpColor::Always, hexutils::HexDumpColor::Never}) {
+            for (size_t bytesPerLine : {1, 7, 16, 33}) {
+                for (unsigned flags = 0; flags < 32; ++flags) {
+                    hexutils::HexDumpOptions options;
+                    options.szBytesPerLine = bytesPerLine;
+                    options.bShowSpaces = flags & 1;
+                    options.bShowAscii = flags & 2;
+                    options.bShowOffset = flags & 4;
+                    options.bDecimalOffset = flags & 8;
+                    options.bSqueeze = (flags & 16) && options.bShowOffset;
+                    options.eStyle = style;
+                    options.eColor = color;
+                    std::string dump = hexutils::HexDumpString(data.data(), data.size(), options);
+                    std::vector<uint8_t> bytes;
+                    match = match && hexutils::HexDumpReverse(dump, bytes, options) && (bytes == data);
+                }
+            }
+        }
+    }
+
+    // fed in chunks split anywhere
+    hexutils::HexDumpOptions options;
+    options.bSqueeze = true;
+    options.eColor = hexutils::HexDumpColor::Always;
+    std::string dump = hexutils::HexDumpString(data.data(), data.size(), options);
+    for (size_t chunk : {1, 2, 5, 64, 4096}) {
+        hexutils::HexDumpReverser reverser(options);
+        std::vector<uint8_t> bytes;
+        auto append = [&bytes](const uint8_t* pData, size_t len) { bytes.insert(bytes.end(), pData, pData + len); };
+        for (size_t pos = 0; pos < dump.size(); pos += chunk) {
+            match = match && reverser.update(dump.data() + pos, std::min(chunk, dump.size() - pos), append);
+        }
+        match = match && reverser.finish(append) && (bytes == data) && (reverser.size() == data.size());
+    }
+
+    // the printf dumps, from a file into a file
+    std::string printed = capture_stdio(hexutils::HexDump1, data.data(), data.size(), 16, true, true, true, false);
+    std::FILE* pIn = std::tmpfile();
+    std::FILE* pOut = std::tmpfile();
+    std::fputs(printed.c_str(), pIn);
+    std::rewind(pIn);
+    match = match && hexutils::HexDumpReverseFile(pIn, pOut) && (read_file(pOut) == std::string(data.begin(), data.end()));
+    std::fclose(pIn);
+
+    // holes in the offsets are zeros, the base offset is the offset of the first byte
+    std::vector<uint8_t> bytes;
+    match = match && hexutils::HexDumpReverse("00000002 | 41 42\n00000006 | 43\n", bytes) &&
+            (bytes == std::vector<uint8_t>{0, 0, 'A', 'B', 0, 0, 'C'});
+    options = {};
+    options.szBaseOffset = 0x100;
+    bytes.clear();
+    match = match && hexutils::HexDumpReverse("00000100 | 4142 | AB\r\n00000102 | 43   | C", bytes, options) &&
+            (bytes == std::vector<uint8_t>{'A', 'B', 'C'});
+
+    // malformed dumps are reported with their line
+    std::string error;
+    for (const char* malformed : {"00000010 | 41\n00000000 | 42\n", "00000000 | 41 42\n*\n", "00000000 | 41 42\n*\n00000005 | 43\n",
+                                  "*\n00000000 | 41\n", "0000000G | 41\n", "00000000 | 414\n", "00000000 | zz\n", "00000000 41\n"}) {
+        bytes.clear();
+        error.clear();
+        match = match && !hexutils::HexDumpReverse(malformed, bytes, {}, &error) && (0 == error.rfind("line ", 0));
+    }
+
+    // offsets past size_t and huge jumps are errors, not gigabytes of zeros
+    for (const char* overflow : {"00000000 | 41\n10000000000000000 | 42\n", "00000000 | 41\n000000000000000000001000000000000000000 | 42\n"}) {
+        bytes.clear();
+        match = match && !hexutils::HexDumpReverse(overflow, bytes, {}, &error) && (error.find("size_t") != std::string::npos) && (bytes.size() == 1);
+    }
+    options = {};
+    options.bDecimalOffset = true;
+    bytes.clear();
+    match = match && !hexutils::HexDumpReverse("00000000 | 41\n99999999999999999999 | 42\n", bytes, options, &error) && (error.find("size_t") != std::string::npos);
+    options = {};
+    options.szBaseOffset = SIZE_MAX - 1;
+    bytes.clear();
+    match = match && !hexutils::HexDumpReverse("FFFFFFFFFFFFFFFE | 41 42 43\n", bytes, options, &error) && (error.find("size_t") != std::string::npos);
+    bytes.clear();
+    match = match && !hexutils::HexDumpReverse("00000000 | 41\n7FFFFFFFFFFF0000 | 42\n", bytes, {}, &error) && (0 == error.rfind("line 2: ", 0)) && (bytes.size() == 1);
+    bytes.clear();
+    match = match && hexutils::HexDumpReverse("00000000 | 41\n00000101 | 42\n", bytes, {}, nullptr, 0x100) && (bytes.size() == 0x102);
+    bytes.clear();
+    match = match && !hexutils::HexDumpReverse("00000000 | 41\n00000102 | 42\n", bytes, {}, nullptr, 0x100);
+
+    std::cout << "HexDumpReverse Test " << (match ? "Passed" : "Failed") << "\n";
+}
+
 int main()
 {
 
@@ -138,6 +795,14 @@ int main()
     test_HexDump2_flag();
     test_HexDump3_direct();
     test_HexDump3_flag();
+    test_HexDumpBuffered_conformance();
+    test_HexDump_column_kernels();
+    test_HexDump_sinks();
+    test_HexDumpParallel();
+    test_HexDump_squeeze();
+    test_HexDumpAnnotated();
+    test_HexDiff();
+    test_HexDumpReverse();
 
     return 0;
 }
@@ -3,6 +3,10 @@
 #include <vector>
 #include <string>
 #include <cstring>
+#include <cstddef>
+#include <iterator>
+#include <sstream>
+#include <cstdio>
 #include "uHexlifyUtils.hpp"
 
 void test_string_hexlify()
@@ -23,6 +27,256 @@ void test_string_unhexlify()
     std::cout << "Test string_unhexlify: " << ((buffer == expected) ? "Passed" : "Failed") << std::endl;
 }
 
+void test_string_hexlify_large()
+{
+    // sizes around the SIMD block widths exercise both the vector loops and the scalar tails
+    bool match = true;
+    for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 4099}) {
+        std::vector<uint8_t> buffer(size);
+        for (size_t i = 0; i < size; ++i) {
+            buffer[i] = static_cast<uint8_t>(i * 37 + 11);
+        }
+        std::string hex;
+        hexutils::string_hexlify(buffer, 0, buffer.size(), hex);
+        std::string expected(size * 2, '\0');
+        hexutils::internal::hex_encode_scalar(buffer.data(), buffer.size(), expected.data());
+        std::vector<uint8_t> roundtrip;
+        bool success = hexutils::string_unhexlify(hex, roundtrip);
+        match = match && (size == 0 || hex == expected) && (success && roundtrip == buffer);
+    }
+    std::cout << "Test string_hexlify (large buffers): " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_string_unhexlify_invalid()
+{
+    // an invalid character anywhere in the input must be rejected, whatever the SIMD block it falls in
+    bool match = true;
+    std::string valid(200, 'a');
+    for (size_t pos = 0; pos < valid.size(); ++pos) {
+        for (char bad : {'g', 'G', '/', ':', '@', '`', ' ', '\x80', '\xFF'}) {
+            std::string hex = valid;
+            hex[pos] = bad;
+            std::vector<uint8_t> buffer;
+            match = match && !hexutils::string_unhexlify(hex, buffer) && (buffer.size() == pos / 2);
+        }
+    }
+    std::vector<uint8_t> buffer;
+    match = match && !hexutils::string_unhexlify("ABC", buffer);
+    match = match && hexutils::string_unhexlify("aBcDeF", buffer) && buffer == std::vector<uint8_t>{0xAB, 0xCD, 0xEF};
+    std::cout << "Test string_unhexlify (invalid input): " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_string_unhexlify_error_offset()
+{
+    uint8_t buffer[8] = {};
+    std::string_view hex = "0123456789abXdef";
+    hexutils::HexResult result = hexutils::string_unhexlify(hex, std::span<uint8_t>(buffer));
+    bool match = !result && result.eStatus == hexutils::HexStatus::InvalidChar && result.szErrorOffset == 12 && result.szWritten == 6;
+
+    result = hexutils::string_unhexlify("0123456789abcdeX", std::span<uint8_t>(buffer));
+    match = match && result.eStatus == hexutils::HexStatus::InvalidChar && result.szErrorOffset == 15;
+
+    result = hexutils::string_unhexlify("012", std::span<uint8_t>(buffer));
+    match = match && result.eStatus == hexutils::HexStatus::OddLength;
+
+    result = hexutils::string_unhexlify("00112233445566778899", std::span<uint8_t>(buffer));
+    match = match && result.eStatus == hexutils::HexStatus::BufferTooSmall;
+
+    result = hexutils::string_unhexlify("DEADBEEF", std::span<uint8_t>(buffer));
+    match = match && result && result.szWritten == 4 && buffer[0] == 0xDE && buffer[3] == 0xEF;
+
+    std::vector<uint8_t> vec;
+    size_t szErrorOffset = 0;
+    match = match && !hexutils::string_unhexlify("00zz", vec, &szErrorOffset) && szErrorOffset == 2;
+
+    std::cout << "Test string_unhexlify (error offset): " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_string_hexlify_span()
+{
+    const std::byte input[] = {std::byte{0x12}, std::byte{0x34}, std::byte{0xAB}, std::byte{0xCD}};
+    char hex[hexutils::hexlified_size(sizeof(input))];
+    size_t written = hexutils::string_hexlify(std::span<const std::byte>(input), std::span<char>(hex));
+    bool match = (written == 8) && (std::string_view(hex, written) == "1234ABCD");
+
+    char small[7];
+    match = match && (hexutils::string_hexlify(std::span<const std::byte>(input), std::span<char>(small)) == 0);
+
+    std::string appended = "hex=";
+    written = hexutils::string_hexlify(std::span<const std::byte>(input), std::back_inserter(appended));
+    match = match && (written == 8) && (appended == "hex=1234ABCD");
+
+    std::byte decoded[4];
+    hexutils::HexResult result = hexutils::string_unhexlify(std::string_view(hex, written), std::span<std::byte>(decoded));
+    match = match && result && (result.szWritten == 4) && (std::memcmp(decoded, input, sizeof(input)) == 0);
+
+    std::vector<uint8_t> collected;
+    result = hexutils::string_unhexlify("00FF10zz", std::back_inserter(collected));
+    match = match && !result && (result.szErrorOffset == 6) && (collected == std::vector<uint8_t>{0x00, 0xFF, 0x10});
+
+    std::cout << "Test string_hexlify (span): " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_string_hexlify_any_span()
+{
+    const uint32_t buffer[] = {0x12345678, 0x9ABCDEF0};
+    char hex[hexutils::hexlified_size_any<uint32_t>(2)];
+    size_t written = hexutils::string_hexlify_any(std::span<const uint32_t>(buffer), std::span<char>(hex), hexutils::Endianness::Big);
+    bool match = (written == sizeof(hex)) && (std::string_view(hex, written) == "42123456789ABCDEF0");
+
+    uint32_t result[2] = {};
+    hexutils::HexResult decoded = hexutils::string_unhexlify_any(std::string_view(hex, written), std::span<uint32_t>(result));
+    match = match && decoded && (result[0] == buffer[0]) && (result[1] == buffer[1]);
+
+    decoded = hexutils::string_unhexlify_any("4C78563412", std::span<uint32_t>(result));
+    match = match && decoded && (result[0] == 0x12345678);
+
+    decoded = hexutils::string_unhexlify_any("5878563412", std::span<uint32_t>(result));
+    match = match && (decoded.eStatus == hexutils::HexStatus::InvalidMarker);
+
+    std::cout << "Test string_hexlify_any (span): " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_hex_stream_codec()
+{
+    std::vector<uint8_t> buffer(1000);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<uint8_t>(i * 13 + 7);
+    }
+    std::string expected;
+    hexutils::string_hexlify(buffer, 0, buffer.size(), expected);
+
+    // chunk sizes which split bytes and leave odd nibbles at the chunk boundaries
+    bool match = true;
+    for (size_t chunk : {1, 3, 7, 64, 999}) {
+        hexutils::HexEncoder encoder;
+        std::string hex;
+        for (size_t i = 0; i < buffer.size(); i += chunk) {
+            hex += encoder.update(std::span<const uint8_t>(buffer.data() + i, std::min(chunk, buffer.size() - i)));
+        }
+        hex += encoder.finish();
+
+        hexutils::HexDecoder decoder;
+        std::vector<uint8_t> decoded;
+        for (size_t i = 0; i < hex.size(); i += chunk) {
+            std::span<const uint8_t> bytes = decoder.update(std::string_view(hex).substr(i, chunk));
+            decoded.insert(decoded.end(), bytes.begin(), bytes.end());
+        }
+        match = match && (hex == expected) && decoder.finish() && (decoded == buffer);
+    }
+
+    hexutils::HexDecoder decoder(true);
+    std::vector<uint8_t> decoded;
+    for (std::string_view part : {"DE A", "D\nBE", "EF\r\n"}) {
+        std::span<const uint8_t> bytes = decoder.update(part);
+        decoded.insert(decoded.end(), bytes.begin(), bytes.end());
+    }
+    match = match && decoder.finish() && (decoded == std::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF});
+
+    decoder.update("ABC");
+    match = match && !decoder.finish() && (decoder.result().eStatus == hexutils::HexStatus::OddLength) && (decoder.result().szErrorOffset == 2);
+    decoder.update("AB");
+    decoder.update("Cx");
+    match = match && !decoder.finish() && (decoder.result().eStatus == hexutils::HexStatus::InvalidChar) && (decoder.result().szErrorOffset == 3);
+
+    std::cout << "Test HexEncoder/HexDecoder: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_hex_stream_adapters()
+{
+    std::string binary = "stream \x01\x02\xFF payload";
+    std::istringstream in(binary);
+    std::ostringstream hex;
+    bool match = hexutils::hexlify_stream(in, hex, 5);
+
+    std::istringstream hexIn(hex.str() + "\n");
+    std::ostringstream out;
+    match = match && hexutils::unhexlify_stream(hexIn, out, 3) && (out.str() == binary);
+
+    std::FILE* pHexFile = std::tmpfile();
+    std::FILE* pBinFile = std::tmpfile();
+    match = match && (nullptr != pHexFile) && (nullptr != pBinFile);
+    if (match) {
+        std::fputs(hex.str().c_str(), pHexFile);
+        std::fflush(pHexFile);
+        std::rewind(pHexFile);
+        match = hexutils::unhexlify_fd(fileno(pHexFile), fileno(pBinFile), 4);
+        std::rewind(pBinFile);
+        char readback[64] = {};
+        size_t szRead = std::fread(readback, 1, sizeof(readback), pBinFile);
+        match = match && (std::string(readback, szRead) == binary);
+    }
+    if (pHexFile) std::fclose(pHexFile);
+    if (pBinFile) std::fclose(pBinFile);
+
+    std::cout << "Test hexlify/unhexlify stream adapters: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+template<typename T>
+bool check_hexlify_any_roundtrip(size_t szCount, hexutils::Endianness endian)
+{
+    std::vector<T> buffer(szCount);
+    for (size_t i = 0; i < szCount; ++i) {
+        buffer[i] = static_cast<T>(0x0123456789ABCDEFULL * (i + 1));
+    }
+    std::string hex;
+    hexutils::string_hexlify_any(buffer, hex, endian);
+
+    // reference: element bytes in the requested order, one element at a time
+    std::string expected = (endian == hexutils::Endianness::Little) ? "4C" : "42";
+    for (T value : buffer) {
+        for (size_t j = 0; j < sizeof(T); ++j) {
+            size_t shift = 8 * ((endian == hexutils::Endianness::Little) ? j : sizeof(T) - 1 - j);
+            uint8_t byte = static_cast<uint8_t>(static_cast<uint64_t>(value) >> shift);
+            expected.push_back(hexutils::internal::g_pstrHexDigits[byte >> 4]);
+            expected.push_back(hexutils::internal::g_pstrHexDigits[byte & 0xF]);
+        }
+    }
+
+    std::vector<T> result;
+    return (hex == expected) && hexutils::string_unhexlify_any(hex, result) && (result == buffer);
+}
+
+void test_string_hexlify_any_roundtrip()
+{
+    bool match = true;
+    for (size_t count : {0, 1, 3, 17, 1000, 3001}) {
+        for (hexutils::Endianness endian : {hexutils::Endianness::Little, hexutils::Endianness::Big}) {
+            match = match && check_hexlify_any_roundtrip<uint8_t>(count, endian);
+            match = match && check_hexlify_any_roundtrip<uint16_t>(count, endian);
+            match = match && check_hexlify_any_roundtrip<uint32_t>(count, endian);
+            match = match && check_hexlify_any_roundtrip<uint64_t>(count, endian);
+        }
+    }
+
+    std::vector<uint32_t> result = {1, 2, 3};
+    match = match && !hexutils::string_unhexlify_any("42000000010000000X", result) && result.empty();
+    std::cout << "Test string_hexlify_any (roundtrip): " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_compile_time_hexlify()
+{
+    // everything below is evaluated by the compiler, the runtime check only reports it
+    constexpr auto signature = hexutils::unhexlify_literal<"DEADbeef">();
+    static_assert(signature.size() == 4 && signature[0] == 0xDE && signature[3] == 0xEF);
+
+    constexpr auto words = hexutils::unhexlify_any_literal<uint32_t, "42123456789ABCDEF0">();
+    static_assert(words.size() == 2 && words[0] == 0x12345678 && words[1] == 0x9ABCDEF0);
+
+    constexpr auto hexBig = hexutils::hexlify_any_array<hexutils::Endianness::Big>(std::array<uint32_t, 2>{0x12345678, 0x9ABCDEF0});
+    static_assert(std::string_view(hexBig.data(), hexBig.size()) == "42123456789ABCDEF0");
+
+    constexpr auto hexLittle = hexutils::hexlify_any_array(std::array<uint16_t, 2>{0x1234, 0xABCD});
+    static_assert(std::string_view(hexLittle.data(), hexLittle.size()) == "4C3412CDAB");
+
+    constexpr auto hexBytes = hexutils::hexlify_array(signature);
+    static_assert(std::string_view(hexBytes.data(), hexBytes.size()) == "DEADBEEF");
+
+    static_assert(hexutils::internal::is_system_little_endian() == (std::endian::native == std::endian::little));
+
+    std::cout << "Test compile-time hexlify: Passed" << std::endl;
+}
+
 void test_string_hexlify_any_little_endian()
 {
     std::vector<uint32_t> buffer = {0x12345678, 0x9ABCDEF0};
@@ -63,10 +317,115 @@ void test_string_unhexlify_any_big_endian()
     std::cout << "Test string_unhexlify_any (Big Endian): " << (match ? "Passed" : "Failed") << std::endl;
 }
 
+void test_string_hexlify_parallel()
+{
+    // small chunks and no threshold force several threads on odd sizes
+    hexutils::ParallelOptions options;
+    options.szChunkSize = 4096;
+    options.szThreshold = 0;
+    options.uThreads = 4;
+
+    bool match = true;
+    for (size_t size : {1, 4095, 4096, 4097, 100000}) {
+        std::vector<uint8_t> buffer(size);
+        for (size_t i = 0; i < size; ++i) {
+            buffer[i] = static_cast<uint8_t>(i * 37 + 11);
+        }
+        std::string expected;
+        std::string hex;
+        hexutils::string_hexlify(buffer, 0, buffer.size(), expected);
+        match = match && hexutils::string_hexlify_parallel(buffer, 0, buffer.size(), hex, options) && (hex == expected);
+
+        // below the threshold the calling thread does the work
+        match = match && hexutils::string_hexlify_parallel(buffer, 0, buffer.size(), hex) && (hex == expected);
+    }
+
+    std::vector<char> small(3);
+    std::vector<uint8_t> two = {0xAB, 0xCD};
+    match = match && (0 == hexutils::string_hexlify_parallel(std::as_bytes(std::span<const uint8_t>(two)), std::span<char>(small), options));
+
+    std::cout << "Test string_hexlify_parallel: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_string_hexlify_format()
+{
+    std::vector<uint8_t> buffer = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+    struct Case { hexutils::HexFormat format; std::string expected; };
+    std::vector<Case> cases = {
+        {{.strBytePrefix = "", .strSeparator = ":", .szGroupSize = 0, .strGroupSeparator = "", .bLowercase = false}, "AA:BB:CC:DD:EE:FF"},
+        {{.strBytePrefix = "0x", .strSeparator = ", ", .szGroupSize = 0, .strGroupSeparator = "", .bLowercase = false}, "0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF"},
+        {{.strBytePrefix = "", .strSeparator = "", .szGroupSize = 4, .strGroupSeparator = " ", .bLowercase = false}, "AABBCCDD EEFF"},
+        {{.strBytePrefix = "", .strSeparator = " ", .szGroupSize = 2, .strGroupSeparator = " | ", .bLowercase = true}, "aa bb | cc dd | ee ff"},
+        {{.strBytePrefix = "", .strSeparator = "", .szGroupSize = 0, .strGroupSeparator = "", .bLowercase = true}, "aabbccddeeff"}};
+
+    bool match = true;
+    for (const Case& test : cases) {
+        std::string hex;
+        match = match && hexutils::string_hexlify(buffer, 0, buffer.size(), hex, test.format) && (hex == test.expected);
+        match = match && (hexutils::hexlified_size(buffer.size(), test.format) == test.expected.size());
+
+        std::vector<uint8_t> decoded;
+        match = match && hexutils::string_unhexlify_tolerant(hex, decoded) && (decoded == buffer);
+    }
+
+    // long groups go through the vector kernels, lowercase included
+    std::vector<uint8_t> large(1000);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    for (const hexutils::HexFormat& format : {hexutils::HexFormat{.strBytePrefix = "", .strSeparator = "", .szGroupSize = 64, .strGroupSeparator = "\n", .bLowercase = true},
+                                               hexutils::HexFormat{.strBytePrefix = "0x", .strSeparator = ",", .szGroupSize = 16, .strGroupSeparator = ",\n", .bLowercase = false}}) {
+        std::string hex;
+        std::vector<uint8_t> decoded;
+        hexutils::string_hexlify(large, 0, large.size(), hex, format);
+        match = match && hexutils::string_unhexlify_tolerant(hex, decoded) && (decoded == large);
+    }
+
+    std::vector<char> small(3);
+    match = match && (0 == hexutils::string_hexlify(std::as_bytes(std::span<const uint8_t>(buffer)), std::span<char>(small), cases[0].format));
+
+    std::cout << "Test string_hexlify_format: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
+void test_string_unhexlify_tolerant_invalid()
+{
+    struct Case { std::string hex; hexutils::HexStatus eStatus; size_t szErrorOffset; };
+    std::vector<Case> cases = {
+        {"AA:B:CC", hexutils::HexStatus::InvalidChar, 4},
+        {"0xAA 0xZZ", hexutils::HexStatus::InvalidChar, 7},
+        {"AA BB C", hexutils::HexStatus::OddLength, 6},
+        {"AABBGG", hexutils::HexStatus::InvalidChar, 4},
+        {std::string(64, 'A') + " " + std::string(31, 'B') + "X", hexutils::HexStatus::InvalidChar, 64 + 1 + 31}};
+
+    bool match = true;
+    for (const Case& test : cases) {
+        std::vector<uint8_t> out(test.hex.size());
+        hexutils::HexResult result = hexutils::string_unhexlify_tolerant(test.hex, std::span<uint8_t>(out));
+        match = match && !result && (result.eStatus == test.eStatus) && (result.szErrorOffset == test.szErrorOffset);
+    }
+
+    std::vector<uint8_t> out(1);
+    match = match && (hexutils::string_unhexlify_tolerant("AA:BB", std::span<uint8_t>(out)).eStatus == hexutils::HexStatus::BufferTooSmall);
+
+    std::cout << "Test string_unhexlify_tolerant invalid: " << (match ? "Passed" : "Failed") << std::endl;
+}
+
 int main()
 {
     test_string_hexlify();
     test_string_unhexlify();
+    test_string_hexlify_large();
+    test_string_unhexlify_invalid();
+    test_string_unhexlify_error_offset();
+    test_string_hexlify_span();
+    test_string_hexlify_parallel();
+    test_string_hexlify_format();
+    test_string_unhexlify_tolerant_invalid();
+    test_string_hexlify_any_span();
+    test_hex_stream_codec();
+    test_hex_stream_adapters();
+    test_string_hexlify_any_roundtrip();
+    test_compile_time_hexlify();
     test_string_hexlify_any_little_endian();
     test_string_unhexlify_any_little_endian();
     test_string_hexlify_any_big_endian();
@@ -0,0 +1,1393 @@
+#ifndef UBASENUTILS_HPP
+#define UBASENUTILS_HPP
+
+#ifndef uBASEN_USE_SIMD
+    #define uBASEN_USE_SIMD   1U
+#endif
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <array>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#if (1 == uBASEN_USE_SIMD)
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #define uBASEN_SIMD_X86     1
+        #include <immintrin.h>
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #define uBASEN_SIMD_NEON    1
+        #include <arm_neon.h>
+    #endif
+#endif /* (1 == uBASEN_USE_SIMD) */
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace basenutils
+ * @brief Provides Base64, Base32 and Base85 (Ascii85 / Z85) encoders and decoders.
+ *
+ * The API mirrors hexutils::string_hexlify() / string_unhexlify(): container based functions returning a bool,
+ * span based functions writing into caller-provided buffers, and incremental encoder/decoder classes.
+ * Every codec is described by a small codec object (Base64Codec, Base32Codec, Base85Codec) which selects
+ * the alphabet and the padding.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace basenutils
+{
+
+/**
+ * @brief Status codes reported by the non-throwing decoders.
+ */
+enum class BaseNStatus {
+    Ok,             /**< Conversion successful */
+    InvalidChar,    /**< The input contains a character outside the alphabet */
+    InvalidLength,  /**< The input ends with an incomplete group */
+    InvalidPadding, /**< Misplaced or malformed padding */
+    Overflow,       /**< A Base85 group exceeds 2^32 - 1 */
+    BufferTooSmall  /**< The output buffer cannot hold the decoded data */
+};
+
+/**
+ * @brief Outcome of a non-throwing decode, or of a BaseNEncoder stream (then szWritten counts characters).
+ */
+struct BaseNResult {
+    BaseNStatus eStatus   = BaseNStatus::Ok; /**< Status of the conversion */
+    size_t szWritten      = 0;               /**< Number of bytes written to the output */
+    size_t szErrorOffset  = 0;               /**< Offset in the input of the first offending character (errors only) */
+
+    explicit operator bool() const noexcept { return BaseNStatus::Ok == eStatus; }
+};
+
+/**
+ * @brief Base64 alphabets (RFC 4648).
+ */
+enum class Base64Alphabet {
+    Standard, /**< A-Z a-z 0-9 + / */
+    UrlSafe   /**< A-Z a-z 0-9 - _ */
+};
+
+/**
+ * @brief Base85 variants.
+ */
+enum class Base85Variant {
+    Ascii85,  /**< Adobe / btoa alphabet '!'..'u', 'z' abbreviates a zero group, partial final group allowed */
+    Z85       /**< ZeroMQ alphabet, input must be a multiple of 4 bytes (5 characters) */
+};
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace internal
+ * @brief Contains internal helper functions for basenutils.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+namespace internal
+{
+
+constexpr char g_pstrBase64Standard[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char g_pstrBase64UrlSafe[]  = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr char g_pstrBase32[]         = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+constexpr char g_pstrZ85[]            = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+constexpr char g_cPadding             = '=';
+constexpr char g_cAscii85ZeroGroup    = 'z';
+
+/**
+ * @brief Marks the characters of the decode tables which are not part of the alphabet.
+ */
+constexpr uint8_t g_u8InvalidChar = 0xFF;
+
+/**
+ * @brief Ascii85 alphabet: the 85 consecutive characters starting at '!'.
+ */
+constexpr std::array<char, 86> g_acAscii85 = []() {
+    std::array<char, 86> alphabet{};
+    for (size_t i = 0; i < 85; ++i) {
+        alphabet[i] = static_cast<char>('!' + i);
+    }
+    return alphabet;
+}();
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Builds the reverse lookup table of an alphabet.
+ * @param pstrAlphabet The alphabet characters.
+ * @param szSize Number of characters in the alphabet.
+ * @return A table mapping every character to its value, or to g_u8InvalidChar.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+constexpr std::array<uint8_t, 256> make_decode_table(const char* pstrAlphabet, size_t szSize) noexcept
+{
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = g_u8InvalidChar;
+    }
+    for (size_t i = 0; i < szSize; ++i) {
+        table[static_cast<uint8_t>(pstrAlphabet[i])] = static_cast<uint8_t>(i);
+    }
+    return table;
+
+} /* make_decode_table() */
+
+constexpr std::array<uint8_t, 256> g_au8Base64StandardTable = make_decode_table(g_pstrBase64Standard, 64);
+constexpr std::array<uint8_t, 256> g_au8Base64UrlSafeTable  = make_decode_table(g_pstrBase64UrlSafe, 64);
+constexpr std::array<uint8_t, 256> g_au8Base32Table         = make_decode_table(g_pstrBase32, 32);
+constexpr std::array<uint8_t, 256> g_au8Ascii85Table        = make_decode_table(g_acAscii85.data(), 85);
+constexpr std::array<uint8_t, 256> g_au8Z85Table            = make_decode_table(g_pstrZ85, 85);
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Fills a BaseNResult describing an error.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline BaseNResult make_error(BaseNStatus eStatus, size_t szErrorOffset, size_t szWritten) noexcept
+{
+    BaseNResult result;
+    result.eStatus = eStatus;
+    result.szErrorOffset = szErrorOffset;
+    result.szWritten = szWritten;
+    return result;
+
+} /* make_error() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the offset of the first character of [pIn, pIn + szLen) missing from a decode table.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t find_invalid(const char* pIn, size_t szLen, const std::array<uint8_t, 256>& table) noexcept
+{
+    size_t i = 0;
+    while ((i < szLen) && (g_u8InvalidChar != table[static_cast<uint8_t>(pIn[i])])) {
+        ++i;
+    }
+    return i;
+
+} /* find_invalid() */
+
+
+#if defined(uBASEN_SIMD_X86)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief AVX2 Base64 encoder (W. Mula / D. Lemire), 24 input bytes per iteration.
+ * @return The number of input bytes consumed, a multiple of 3; the rest is left to the scalar code.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+inline size_t base64_encode_avx2(const uint8_t* pIn, size_t szLen, char* pOut, bool bUrlSafe)
+{
+    /* spread the 3 input bytes of every 32-bit lane as b1 b0 b2 b1 */
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const char c62 = bUrlSafe ? '-' : '+';
+    const char c63 = bUrlSafe ? '_' : '/';
+    const __m256i shiftLut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                              '0' - 52, '0' - 52, '0' - 52, c62 - 62, c63 - 63, 'A', 0, 0,
+                                              'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                              '0' - 52, '0' - 52, '0' - 52, c62 - 62, c63 - 63, 'A', 0, 0);
+    size_t i = 0;
+    size_t o = 0;
+
+    /* every iteration reads 28 bytes */
+    for (; i + 32 <= szLen; i += 24, o += 32) {
+        const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i + 12));
+        const __m256i in   = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), shuffle);
+
+        /* extract the four 6-bit indices of every 32-bit lane */
+        const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t0, t1);
+
+        /* map each index range onto its ASCII offset */
+        __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        reduced = _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        const __m256i chars = _mm256_add_epi8(indices, _mm256_shuffle_epi8(shiftLut, reduced));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + o), chars);
+    }
+
+    return i;
+
+} /* base64_encode_avx2() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief AVX2 Base64 decoder (W. Mula / D. Lemire), 32 input characters per iteration.
+ *
+ * Stops at the first block holding a character outside the alphabet (including padding) and leaves it
+ * to the scalar code, which reports the exact error. Every iteration stores 32 bytes (24 valid),
+ * so the loop also stops when the output buffer has less than 32 bytes left.
+ *
+ * @return The number of input characters consumed, a multiple of 32.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+inline size_t base64_decode_avx2(const char* pIn, size_t szLen, uint8_t* pOut, size_t szOutCapacity, bool bUrlSafe)
+{
+    const __m256i lutLow  = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                             0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHigh = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                             0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i packShuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    size_t o = 0;
+
+    for (; (i + 32 <= szLen) && (o + 32 <= szOutCapacity); i += 32, o += 24) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + i));
+
+        if (bUrlSafe) {
+            /* translate '-' and '_' to '+' and '/', and turn the original '+' and '/' into invalid characters */
+            const __m256i isPlusOrSlash = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(chars, slash));
+            chars = _mm256_blendv_epi8(chars, _mm256_set1_epi8('+'), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('-')));
+            chars = _mm256_blendv_epi8(chars, slash, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_')));
+            chars = _mm256_or_si256(chars, _mm256_and_si256(isPlusOrSlash, _mm256_set1_epi8(static_cast<char>(0x80))));
+        }
+
+        const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), nibbleMask);
+        const __m256i lowNibbles  = _mm256_and_si256(chars, nibbleMask);
+        const __m256i high = _mm256_shuffle_epi8(lutHigh, highNibbles);
+        const __m256i low  = _mm256_shuffle_epi8(lutLow, lowNibbles);
+        if (!_mm256_testz_si256(low, high)) {
+            break;
+        }
+
+        const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(chars, slash), highNibbles));
+        const __m256i values = _mm256_add_epi8(chars, roll);
+
+        /* pack four 6-bit values into three bytes per 32-bit lane */
+        const __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, packShuffle), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + o), packed);
+    }
+
+    return i;
+
+} /* base64_decode_avx2() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Tells once whether the running CPU supports AVX2.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool cpu_has_avx2()
+{
+    static const bool bAvx2 = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+
+    return bAvx2;
+
+} /* cpu_has_avx2() */
+
+#elif defined(uBASEN_SIMD_NEON)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief NEON Base64 encoder, 48 input bytes per iteration.
+ * @return The number of input bytes consumed, a multiple of 3.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t base64_encode_neon(const uint8_t* pIn, size_t szLen, char* pOut, const char* pstrAlphabet)
+{
+    const uint8x16x4_t alphabet = vld1q_u8_x4(reinterpret_cast<const uint8_t*>(pstrAlphabet));
+    const uint8x16_t mask = vdupq_n_u8(0x3F);
+    size_t i = 0;
+    size_t o = 0;
+
+    for (; i + 48 <= szLen; i += 48, o += 64) {
+        const uint8x16x3_t in = vld3q_u8(pIn + i);
+        uint8x16x4_t out;
+        out.val[0] = vqtbl4q_u8(alphabet, vshrq_n_u8(in.val[0], 2));
+        out.val[1] = vqtbl4q_u8(alphabet, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask));
+        out.val[2] = vqtbl4q_u8(alphabet, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask));
+        out.val[3] = vqtbl4q_u8(alphabet, vandq_u8(in.val[2], mask));
+        vst4q_u8(reinterpret_cast<uint8_t*>(pOut + o), out);
+    }
+
+    return i;
+
+} /* base64_encode_neon() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief NEON Base64 decoder, 64 input characters per iteration; stops at the first invalid block.
+ * @return The number of input characters consumed, a multiple of 64.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t base64_decode_neon(const char* pIn, size_t szLen, uint8_t* pOut, const std::array<uint8_t, 256>& table)
+{
+    const uint8x16x4_t tableLow  = vld1q_u8_x4(table.data());
+    const uint8x16x4_t tableHigh = vld1q_u8_x4(table.data() + 64);
+    const uint8x16_t offset = vdupq_n_u8(64);
+    size_t i = 0;
+    size_t o = 0;
+
+    for (; i + 64 <= szLen; i += 64, o += 48) {
+        const uint8x16x4_t chars = vld4q_u8(reinterpret_cast<const uint8_t*>(pIn + i));
+        uint8x16_t values[4];
+        uint8x16_t errors = vdupq_n_u8(0);
+        for (int k = 0; k < 4; ++k) {
+            /* characters >= 128 miss both tables and keep the 0 of the first lookup, their own bit 7 flags them */
+            values[k] = vqtbx4q_u8(vqtbl4q_u8(tableLow, chars.val[k]), tableHigh, vsubq_u8(chars.val[k], offset));
+            errors = vorrq_u8(errors, vorrq_u8(values[k], chars.val[k]));
+        }
+        if (vmaxvq_u8(errors) & 0x80) {
+            break;
+        }
+
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(values[0], 2), vshrq_n_u8(values[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(values[1], 4), vshrq_n_u8(values[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(values[2], 6), values[3]);
+        vst3q_u8(pOut + o, bytes);
+    }
+
+    return i;
+
+} /* base64_decode_neon() */
+
+#endif /* uBASEN_SIMD_X86 / uBASEN_SIMD_NEON */
+
+}  /* namespace internal */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @struct Base64Codec
+ * @brief Base64 codec (RFC 4648), standard or URL-safe alphabet, with optional padding.
+ *
+ * The decoder accepts padded and unpadded input; padding, when present, must be well-formed
+ * and must terminate the input.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+struct Base64Codec
+{
+    static constexpr size_t szInBlock  = 3;   ///< Bytes per group.
+    static constexpr size_t szOutBlock = 4;   ///< Characters per group.
+
+    Base64Alphabet eAlphabet = Base64Alphabet::Standard; ///< Alphabet used by the encoder and the decoder.
+    bool bPadding = true;                                ///< If true, the encoder pads the last group with '='.
+
+    /**
+     * @brief Returns the exact number of characters produced for szBytes bytes.
+     */
+    constexpr size_t encoded_size(size_t szBytes) const noexcept
+    {
+        constexpr size_t aszTail[] = {0, 2, 3};
+        return bPadding ? ((szBytes + 2) / 3) * 4 : (szBytes / 3) * 4 + aszTail[szBytes % 3];
+    }
+
+    /**
+     * @brief Returns the number of bytes the given input decodes to (exact for valid input).
+     */
+    constexpr size_t decoded_size(std::string_view in) const noexcept
+    {
+        size_t szChars = in.size();
+        for (int i = 0; (i < 2) && (szChars > 0) && (internal::g_cPadding == in[szChars - 1]); ++i) {
+            --szChars;
+        }
+        constexpr size_t aszTail[] = {0, 0, 1, 2};
+        return (szChars / 4) * 3 + aszTail[szChars % 4];
+    }
+
+    /**
+     * @brief Tells whether a group ending with this character terminates the input.
+     */
+    constexpr bool is_final_group(char cLast) const noexcept { return internal::g_cPadding == cLast; }
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Encodes szLen bytes, including the final partial group.
+     * @return The number of characters written, encoded_size(szLen).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    size_t encode(const uint8_t* pIn, size_t szLen, char* pOut) const noexcept
+    {
+        const bool bUrlSafe = (Base64Alphabet::UrlSafe == eAlphabet);
+        const char* pstrAlphabet = bUrlSafe ? internal::g_pstrBase64UrlSafe : internal::g_pstrBase64Standard;
+        size_t i = 0;
+
+#if defined(uBASEN_SIMD_X86)
+        if (internal::cpu_has_avx2()) {
+            i = internal::base64_encode_avx2(pIn, szLen, pOut, bUrlSafe);
+        }
+#elif defined(uBASEN_SIMD_NEON)
+        i = internal::base64_encode_neon(pIn, szLen, pOut, pstrAlphabet);
+#endif
+
+        size_t o = (i / 3) * 4;
+        for (; i + 3 <= szLen; i += 3, o += 4) {
+            uint32_t value = (uint32_t(pIn[i]) << 16) | (uint32_t(pIn[i + 1]) << 8) | pIn[i + 2];
+            pOut[o]     = pstrAlphabet[(value >> 18) & 0x3F];
+            pOut[o + 1] = pstrAlphabet[(value >> 12) & 0x3F];
+            pOut[o + 2] = pstrAlphabet[(value >> 6) & 0x3F];
+            pOut[o + 3] = pstrAlphabet[value & 0x3F];
+        }
+
+        if (i < szLen) {
+            uint32_t value = uint32_t(pIn[i]) << 16;
+            if (i + 1 < szLen) {
+                value |= uint32_t(pIn[i + 1]) << 8;
+            }
+            pOut[o++] = pstrAlphabet[(value >> 18) & 0x3F];
+            pOut[o++] = pstrAlphabet[(value >> 12) & 0x3F];
+            if (i + 1 < szLen) {
+                pOut[o++] = pstrAlphabet[(value >> 6) & 0x3F];
+            } else if (bPadding) {
+                pOut[o++] = internal::g_cPadding;
+            }
+            if (bPadding) {
+                pOut[o++] = internal::g_cPadding;
+            }
+        }
+
+        return o;
+
+    } /* encode() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Decodes the groups of the input.
+     * @param in The input characters.
+     * @param out The output buffer, must hold at least decoded_size(in) bytes.
+     * @param bFinal If false, a trailing incomplete group is left unconsumed (streaming).
+     * @param szConsumed Receives the number of input characters consumed.
+     * @return The outcome of the conversion, error offsets are relative to in.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    BaseNResult decode(std::string_view in, std::span<uint8_t> out, bool bFinal, size_t& szConsumed) const noexcept
+    {
+        const bool bUrlSafe = (Base64Alphabet::UrlSafe == eAlphabet);
+        const std::array<uint8_t, 256>& table = bUrlSafe ? internal::g_au8Base64UrlSafeTable : internal::g_au8Base64StandardTable;
+        const char* pIn = in.data();
+        const size_t szLen = in.size();
+        uint8_t* pOut = out.data();
+        size_t i = 0;
+
+#if defined(uBASEN_SIMD_X86)
+        if (internal::cpu_has_avx2()) {
+            i = internal::base64_decode_avx2(pIn, szLen, pOut, out.size(), bUrlSafe);
+        }
+#elif defined(uBASEN_SIMD_NEON)
+        i = internal::base64_decode_neon(pIn, szLen, pOut, table);
+#endif
+
+        size_t o = (i / 4) * 3;
+        BaseNResult result;
+
+        for (; i + 4 <= szLen; i += 4, o += 3) {
+            uint8_t a = table[static_cast<uint8_t>(pIn[i])];
+            uint8_t b = table[static_cast<uint8_t>(pIn[i + 1])];
+            uint8_t c = table[static_cast<uint8_t>(pIn[i + 2])];
+            uint8_t d = table[static_cast<uint8_t>(pIn[i + 3])];
+            if ((a | b | c | d) & 0xC0) {
+                break;
+            }
+            uint32_t value = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | d;
+            pOut[o]     = static_cast<uint8_t>(value >> 16);
+            pOut[o + 1] = static_cast<uint8_t>(value >> 8);
+            pOut[o + 2] = static_cast<uint8_t>(value);
+        }
+
+        size_t szRemaining = szLen - i;
+        do {
+            if (0 == szRemaining) {
+                break;
+            }
+
+            /* the group is complete, or the input is final: locate the padding, if any */
+            if ((szRemaining < 4) && !bFinal) {
+                break;
+            }
+
+            size_t szGroup = std::min<size_t>(szRemaining, 4);
+            size_t szData = szGroup;
+            while ((szData > 0) && (internal::g_cPadding == pIn[i + szData - 1])) {
+                --szData;
+            }
+
+            size_t szInvalid = internal::find_invalid(pIn + i, szData, table);
+            if (szInvalid < szData) {
+                result = internal::make_error(BaseNStatus::InvalidChar, i + szInvalid, o);
+                break;
+            }
+            if (szData < 2) {
+                /* a lone character, or padding starting too early */
+                bool bLone = (szData == szGroup);
+                result = internal::make_error(bLone ? BaseNStatus::InvalidLength : BaseNStatus::InvalidPadding, i + (bLone ? 0 : szData), o);
+                break;
+            }
+            if ((szGroup != szData) && (szGroup != 4)) {
+                /* padding present but incomplete */
+                result = internal::make_error(BaseNStatus::InvalidPadding, i + szData, o);
+                break;
+            }
+            if (szRemaining > szGroup) {
+                /* data after a padded group */
+                result = internal::make_error(BaseNStatus::InvalidPadding, i + szGroup, o);
+                break;
+            }
+
+            uint32_t value = 0;
+            for (size_t k = 0; k < 4; ++k) {
+                value = (value << 6) | ((k < szData) ? table[static_cast<uint8_t>(pIn[i + k])] : 0);
+            }
+            for (size_t k = 0; k + 1 < szData; ++k) {
+                pOut[o++] = static_cast<uint8_t>(value >> (16 - 8 * k));
+            }
+            i += szGroup;
+
+        } while (false);
+
+        szConsumed = i;
+        result.szWritten = o;
+        return result;
+
+    } /* decode() */
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @struct Base32Codec
+ * @brief Base32 codec (RFC 4648 alphabet A-Z 2-7), with optional padding.
+ *
+ * The decoder accepts padded and unpadded input; padding, when present, must terminate the input.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+struct Base32Codec
+{
+    static constexpr size_t szInBlock  = 5;   ///< Bytes per group.
+    static constexpr size_t szOutBlock = 8;   ///< Characters per group.
+
+    bool bPadding = true;  ///< If true, the encoder pads the last group with '='.
+
+    /**
+     * @brief Returns the exact number of characters produced for szBytes bytes.
+     */
+    constexpr size_t encoded_size(size_t szBytes) const noexcept
+    {
+        constexpr size_t aszTail[] = {0, 2, 4, 5, 7};
+        return bPadding ? ((szBytes + 4) / 5) * 8 : (szBytes / 5) * 8 + aszTail[szBytes % 5];
+    }
+
+    /**
+     * @brief Returns the number of bytes the given input decodes to (exact for valid input).
+     */
+    constexpr size_t decoded_size(std::string_view in) const noexcept
+    {
+        size_t szChars = in.size();
+        for (int i = 0; (i < 6) && (szChars > 0) && (internal::g_cPadding == in[szChars - 1]); ++i) {
+            --szChars;
+        }
+        return (szChars * 5) / 8;
+    }
+
+    /**
+     * @brief Tells whether a group ending with this character terminates the input.
+     */
+    constexpr bool is_final_group(char cLast) const noexcept { return internal::g_cPadding == cLast; }
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Encodes szLen bytes, including the final partial group.
+     * @return The number of characters written, encoded_size(szLen).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    size_t encode(const uint8_t* pIn, size_t szLen, char* pOut) const noexcept
+    {
+        const char* pstrAlphabet = internal::g_pstrBase32;
+        size_t i = 0;
+        size_t o = 0;
+
+        for (; i + 5 <= szLen; i += 5, o += 8) {
+            uint64_t value = 0;
+            for (size_t k = 0; k < 5; ++k) {
+                value = (value << 8) | pIn[i + k];
+            }
+            for (size_t k = 0; k < 8; ++k) {
+                pOut[o + k] = pstrAlphabet[(value >> (35 - 5 * k)) & 0x1F];
+            }
+        }
+
+        if (i < szLen) {
+            size_t szTail = szLen - i;
+            uint64_t value = 0;
+            for (size_t k = 0; k < 5; ++k) {
+                value = (value << 8) | ((k < szTail) ? pIn[i + k] : 0);
+            }
+            size_t szChars = (szTail * 8 + 4) / 5;
+            for (size_t k = 0; k < szChars; ++k) {
+                pOut[o++] = pstrAlphabet[(value >> (35 - 5 * k)) & 0x1F];
+            }
+            if (bPadding) {
+                for (size_t k = szChars; k < 8; ++k) {
+                    pOut[o++] = internal::g_cPadding;
+                }
+            }
+        }
+
+        return o;
+
+    } /* encode() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Decodes the groups of the input, see Base64Codec::decode().
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    BaseNResult decode(std::string_view in, std::span<uint8_t> out, bool bFinal, size_t& szConsumed) const noexcept
+    {
+        const std::array<uint8_t, 256>& table = internal::g_au8Base32Table;
+        const char* pIn = in.data();
+        const size_t szLen = in.size();
+        uint8_t* pOut = out.data();
+        size_t i = 0;
+        size_t o = 0;
+        BaseNResult result;
+
+        for (; i + 8 <= szLen; i += 8, o += 5) {
+            uint64_t value = 0;
+            uint8_t u8Check = 0;
+            for (size_t k = 0; k < 8; ++k) {
+                uint8_t v = table[static_cast<uint8_t>(pIn[i + k])];
+                u8Check |= v;
+                value = (value << 5) | (v & 0x1F);
+            }
+            if (u8Check & 0xE0) {
+                break;
+            }
+            for (size_t k = 0; k < 5; ++k) {
+                pOut[o + k] = static_cast<uint8_t>(value >> (32 - 8 * k));
+            }
+        }
+
+        size_t szRemaining = szLen - i;
+        do {
+            if ((0 == szRemaining) || ((szRemaining < 8) && !bFinal)) {
+                break;
+            }
+
+            size_t szGroup = std::min<size_t>(szRemaining, 8);
+            size_t szData = szGroup;
+            while ((szData > 0) && (internal::g_cPadding == pIn[i + szData - 1])) {
+                --szData;
+            }
+
+            size_t szInvalid = internal::find_invalid(pIn + i, szData, table);
+            if (szInvalid < szData) {
+                result = internal::make_error(BaseNStatus::InvalidChar, i + szInvalid, o);
+                break;
+            }
+
+            /* only 2, 4, 5 or 7 data characters can end a group */
+            bool bValidTail = (szData == 2) || (szData == 4) || (szData == 5) || (szData == 7);
+            if (!bValidTail || ((szGroup != szData) && (szGroup != 8))) {
+                result = internal::make_error((szGroup == szData) ? BaseNStatus::InvalidLength : BaseNStatus::InvalidPadding, i + szData, o);
+                break;
+            }
+            if (szRemaining > szGroup) {
+                result = internal::make_error(BaseNStatus::InvalidPadding, i + szGroup, o);
+                break;
+            }
+
+            uint64_t value = 0;
+            for (size_t k = 0; k < 8; ++k) {
+                value = (value << 5) | ((k < szData) ? table[static_cast<uint8_t>(pIn[i + k])] : 0);
+            }
+            for (size_t k = 0; k < (szData * 5) / 8; ++k) {
+                pOut[o++] = static_cast<uint8_t>(value >> (32 - 8 * k));
+            }
+            i += szGroup;
+
+        } while (false);
+
+        szConsumed = i;
+        result.szWritten = o;
+        return result;
+
+    } /* decode() */
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @struct Base85Codec
+ * @brief Base85 codec: Ascii85 (without the <~ ~> delimiters) or Z85.
+ *
+ * Each group of 4 bytes is read as a big-endian 32-bit value and written as 5 base-85 digits.
+ * Ascii85 abbreviates an all-zero group as 'z' and encodes a final group of n bytes as n + 1 characters.
+ * Z85 requires whole groups; any other length is rejected.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+struct Base85Codec
+{
+    static constexpr size_t szInBlock  = 4;   ///< Bytes per group.
+    static constexpr size_t szOutBlock = 5;   ///< Characters per group.
+
+    Base85Variant eVariant = Base85Variant::Ascii85;  ///< Alphabet and rules.
+
+    /**
+     * @brief Returns the maximum number of characters produced for szBytes bytes ('z' groups are shorter).
+     */
+    constexpr size_t encoded_size(size_t szBytes) const noexcept
+    {
+        return (szBytes / 4) * 5 + ((szBytes % 4) ? (szBytes % 4) + 1 : 0);
+    }
+
+    /**
+     * @brief Returns the number of bytes the given input decodes to (exact for valid input).
+     */
+    constexpr size_t decoded_size(std::string_view in) const noexcept
+    {
+        size_t szBytes = 0;
+        size_t i = 0;
+        while (i < in.size()) {
+            if ((Base85Variant::Ascii85 == eVariant) && (internal::g_cAscii85ZeroGroup == in[i])) {
+                szBytes += 4;
+                ++i;
+            } else {
+                size_t szGroup = std::min<size_t>(in.size() - i, 5);
+                szBytes += (szGroup > 1) ? szGroup - 1 : 0;
+                i += szGroup;
+            }
+        }
+        return szBytes;
+    }
+
+    /**
+     * @brief Base85 has no padding, no group terminates the input.
+     */
+    constexpr bool is_final_group(char) const noexcept { return false; }
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Encodes szLen bytes, including the final partial group (Ascii85 only).
+     * @return The number of characters written, 0 if Z85 input is not a multiple of 4 bytes.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    size_t encode(const uint8_t* pIn, size_t szLen, char* pOut) const noexcept
+    {
+        const bool bAscii85 = (Base85Variant::Ascii85 == eVariant);
+        const char* pstrAlphabet = bAscii85 ? internal::g_acAscii85.data() : internal::g_pstrZ85;
+
+        if (!bAscii85 && (szLen % 4 != 0)) {
+            return 0;
+        }
+
+        size_t i = 0;
+        size_t o = 0;
+        for (; i < szLen; i += 4) {
+            size_t szGroup = std::min<size_t>(szLen - i, 4);
+            uint32_t value = 0;
+            for (size_t k = 0; k < 4; ++k) {
+                value = (value << 8) | ((k < szGroup) ? pIn[i + k] : 0);
+            }
+
+            if (bAscii85 && (0 == value) && (4 == szGroup)) {
+                pOut[o++] = internal::g_cAscii85ZeroGroup;
+                continue;
+            }
+
+            char acDigits[5];
+            for (int k = 4; k >= 0; --k) {
+                acDigits[k] = pstrAlphabet[value % 85];
+                value /= 85;
+            }
+            std::memcpy(pOut + o, acDigits, szGroup + 1);
+            o += szGroup + 1;
+        }
+
+        return o;
+
+    } /* encode() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Decodes the groups of the input, see Base64Codec::decode().
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    BaseNResult decode(std::string_view in, std::span<uint8_t> out, bool bFinal, size_t& szConsumed) const noexcept
+    {
+        const bool bAscii85 = (Base85Variant::Ascii85 == eVariant);
+        const std::array<uint8_t, 256>& table = bAscii85 ? internal::g_au8Ascii85Table : internal::g_au8Z85Table;
+        const char* pIn = in.data();
+        const size_t szLen = in.size();
+        uint8_t* pOut = out.data();
+        size_t i = 0;
+        size_t o = 0;
+        BaseNResult result;
+
+        while (i < szLen) {
+            if (bAscii85 && (internal::g_cAscii85ZeroGroup == pIn[i])) {
+                std::memset(pOut + o, 0, 4);
+                o += 4;
+                ++i;
+                continue;
+            }
+
+            size_t szGroup = std::min<size_t>(szLen - i, 5);
+            if ((szGroup < 5) && !bFinal) {
+                break;
+            }
+
+            size_t szInvalid = internal::find_invalid(pIn + i, szGroup, table);
+            if (szInvalid < szGroup) {
+                result = internal::make_error(BaseNStatus::InvalidChar, i + szInvalid, o);
+                break;
+            }
+            if ((szGroup < 5) && (!bAscii85 || (szGroup < 2))) {
+                result = internal::make_error(BaseNStatus::InvalidLength, i + szGroup - 1, o);
+                break;
+            }
+
+            /* a partial group is completed with the highest digit, then truncated */
+            uint64_t value = 0;
+            for (size_t k = 0; k < 5; ++k) {
+                value = value * 85 + ((k < szGroup) ? table[static_cast<uint8_t>(pIn[i + k])] : 84);
+            }
+            if (value > 0xFFFFFFFFULL) {
+                result = internal::make_error(BaseNStatus::Overflow, i, o);
+                break;
+            }
+            for (size_t k = 0; k + 1 < szGroup; ++k) {
+                pOut[o++] = static_cast<uint8_t>(value >> (24 - 8 * k));
+            }
+            i += szGroup;
+        }
+
+        szConsumed = i;
+        result.szWritten = o;
+        return result;
+
+    } /* decode() */
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Encodes a buffer of bytes into a caller-provided buffer.
+ * @tparam Codec Base64Codec, Base32Codec or Base85Codec.
+ * @param codec The codec settings.
+ * @param in The input bytes.
+ * @param out The output buffer, must hold at least codec.encoded_size(in.size()) characters.
+ * @return The number of characters written, 0 if the output buffer is too small or the input is rejected.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Codec>
+size_t string_encode(const Codec& codec, std::span<const std::byte> in, std::span<char> out) noexcept
+{
+    size_t szWritten = 0;
+
+    do {
+        if (out.size() < codec.encoded_size(in.size())) {
+            break;
+        }
+
+        szWritten = codec.encode(reinterpret_cast<const uint8_t*>(in.data()), in.size(), out.data());
+
+    } while (false);
+
+    return szWritten;
+
+} /* string_encode() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Decodes a string into a caller-provided buffer, without throwing.
+ * @tparam Codec Base64Codec, Base32Codec or Base85Codec.
+ * @param codec The codec settings.
+ * @param in The input characters.
+ * @param out The output buffer, must hold at least codec.decoded_size(in) bytes.
+ * @return The outcome of the conversion: bytes written and, on error, status and offending offset.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Codec>
+BaseNResult string_decode(const Codec& codec, std::string_view in, std::span<std::byte> out) noexcept
+{
+    BaseNResult result;
+
+    do {
+        if (out.size() < codec.decoded_size(in)) {
+            result.eStatus = BaseNStatus::BufferTooSmall;
+            break;
+        }
+
+        size_t szConsumed = 0;
+        result = codec.decode(in, std::span<uint8_t>(reinterpret_cast<uint8_t*>(out.data()), out.size()), true, szConsumed);
+
+    } while (false);
+
+    return result;
+
+} /* string_decode() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Encodes a buffer of bytes into a string, same shape as hexutils::string_hexlify().
+ * @tparam Codec Base64Codec, Base32Codec or Base85Codec.
+ * @param codec The codec settings.
+ * @param InBuffer The input buffer of bytes.
+ * @param szOffset The offset in the input buffer to start conversion.
+ * @param szNrElems The number of elements to convert.
+ * @param OutBuffer The output string.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Codec>
+bool string_encode(const Codec& codec, const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer)
+{
+    bool bRetVal = false;
+
+    do {
+        if (szOffset > InBuffer.size()) {
+            break;
+        }
+
+        szNrElems = std::min(szNrElems, InBuffer.size() - szOffset);
+        OutBuffer.resize(codec.encoded_size(szNrElems));
+        size_t szWritten = codec.encode(InBuffer.data() + szOffset, szNrElems, OutBuffer.data());
+        OutBuffer.resize(szWritten);
+
+        bRetVal = (szWritten > 0) || (0 == szNrElems);
+    } while (false);
+
+    return bRetVal;
+
+} /* string_encode() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Decodes a string into a buffer of bytes, same shape as hexutils::string_unhexlify().
+ * @tparam Codec Base64Codec, Base32Codec or Base85Codec.
+ * @param codec The codec settings.
+ * @param in The input string.
+ * @param result The output buffer; on error it holds the bytes decoded before the offending character.
+ * @param pszErrorOffset Optional, receives the offset of the first offending character on error.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Codec>
+bool string_decode(const Codec& codec, std::string_view in, std::vector<uint8_t>& result, size_t* pszErrorOffset = nullptr)
+{
+    result.resize(codec.decoded_size(in));
+
+    size_t szConsumed = 0;
+    BaseNResult decoded = codec.decode(in, std::span<uint8_t>(result), true, szConsumed);
+    result.resize(decoded.szWritten);
+
+    if (!decoded && (nullptr != pszErrorOffset)) {
+        *pszErrorOffset = decoded.szErrorOffset;
+    }
+
+    return static_cast<bool>(decoded);
+
+} /* string_decode() */
+
+
+
+/**
+ * @brief Base64 (standard alphabet, padded) encoder, see string_encode().
+ */
+inline bool string_base64_encode(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer, Base64Codec codec = {})
+{
+    return string_encode(codec, InBuffer, szOffset, szNrElems, OutBuffer);
+}
+
+/**
+ * @brief Base64 (standard alphabet) decoder, see string_decode().
+ */
+inline bool string_base64_decode(std::string_view in, std::vector<uint8_t>& result, Base64Codec codec = {}, size_t* pszErrorOffset = nullptr)
+{
+    return string_decode(codec, in, result, pszErrorOffset);
+}
+
+/**
+ * @brief Base64 URL-safe (unpadded) encoder, see string_encode().
+ */
+inline bool string_base64url_encode(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer)
+{
+    return string_encode(Base64Codec{Base64Alphabet::UrlSafe, false}, InBuffer, szOffset, szNrElems, OutBuffer);
+}
+
+/**
+ * @brief Base64 URL-safe decoder (padding optional), see string_decode().
+ */
+inline bool string_base64url_decode(std::string_view in, std::vector<uint8_t>& result, size_t* pszErrorOffset = nullptr)
+{
+    return string_decode(Base64Codec{Base64Alphabet::UrlSafe, false}, in, result, pszErrorOffset);
+}
+
+/**
+ * @brief Base32 (padded) encoder, see string_encode().
+ */
+inline bool string_base32_encode(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer, Base32Codec codec = {})
+{
+    return string_encode(codec, InBuffer, szOffset, szNrElems, OutBuffer);
+}
+
+/**
+ * @brief Base32 decoder (padding optional), see string_decode().
+ */
+inline bool string_base32_decode(std::string_view in, std::vector<uint8_t>& result, size_t* pszErrorOffset = nullptr)
+{
+    return string_decode(Base32Codec{}, in, result, pszErrorOffset);
+}
+
+/**
+ * @brief Ascii85 encoder, see string_encode().
+ */
+inline bool string_ascii85_encode(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer)
+{
+    return string_encode(Base85Codec{Base85Variant::Ascii85}, InBuffer, szOffset, szNrElems, OutBuffer);
+}
+
+/**
+ * @brief Ascii85 decoder, see string_decode().
+ */
+inline bool string_ascii85_decode(std::string_view in, std::vector<uint8_t>& result, size_t* pszErrorOffset = nullptr)
+{
+    return string_decode(Base85Codec{Base85Variant::Ascii85}, in, result, pszErrorOffset);
+}
+
+/**
+ * @brief Z85 encoder, the number of bytes must be a multiple of 4; see string_encode().
+ */
+inline bool string_z85_encode(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer)
+{
+    return string_encode(Base85Codec{Base85Variant::Z85}, InBuffer, szOffset, szNrElems, OutBuffer);
+}
+
+/**
+ * @brief Z85 decoder, the number of characters must be a multiple of 5; see string_decode().
+ */
+inline bool string_z85_decode(std::string_view in, std::vector<uint8_t>& result, size_t* pszErrorOffset = nullptr)
+{
+    return string_decode(Base85Codec{Base85Variant::Z85}, in, result, pszErrorOffset);
+}
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @class BaseNEncoder
+ * @brief Incremental encoder with constant memory, the counterpart of hexutils::HexEncoder.
+ *
+ * Bytes which do not fill a whole group are carried over to the next update(); finish() encodes them
+ * with the final padding. A final partial group the codec cannot encode (Z85) is reported by result()
+ * as InvalidLength at the stream offset of its first byte, szWritten counting the characters.
+ *
+ * @tparam Codec Base64Codec, Base32Codec or Base85Codec.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Codec>
+class BaseNEncoder
+{
+public:
+
+    explicit BaseNEncoder(Codec codec = {})
+        : m_Codec(codec)
+    {}
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Encodes the next chunk of input.
+     * @param chunk The input bytes.
+     * @return The characters of all the groups completed so far, valid until the next call on this encoder.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    std::string_view update(std::span<const uint8_t> chunk)
+    {
+        if (m_bFinished) {
+            m_result = BaseNResult{};
+            m_szStreamPos = 0;
+            m_bFinished = false;
+        }
+        m_szStreamPos += chunk.size();
+
+        m_strBuffer.resize(m_Codec.encoded_size(m_szCarry + chunk.size()));
+        size_t szOut = 0;
+
+        /* complete the carried group first */
+        if (m_szCarry > 0) {
+            size_t szTake = std::min(Codec::szInBlock - m_szCarry, chunk.size());
+            std::memcpy(m_au8Carry + m_szCarry, chunk.data(), szTake);
+            m_szCarry += szTake;
+            chunk = chunk.subspan(szTake);
+            if (m_szCarry == Codec::szInBlock) {
+                szOut += m_Codec.encode(m_au8Carry, Codec::szInBlock, m_strBuffer.data());
+                m_szCarry = 0;
+            }
+        }
+
+        size_t szWhole = (chunk.size() / Codec::szInBlock) * Codec::szInBlock;
+        szOut += m_Codec.encode(chunk.data(), szWhole, m_strBuffer.data() + szOut);
+
+        std::memcpy(m_au8Carry + m_szCarry, chunk.data() + szWhole, chunk.size() - szWhole);
+        m_szCarry += chunk.size() - szWhole;
+
+        m_result.szWritten += szOut;
+        return std::string_view(m_strBuffer.data(), szOut);
+
+    } /* update() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Encodes the carried bytes with the final padding and makes the encoder ready for a new stream.
+     * @return The remaining characters, valid until the next call on this encoder; empty, with result()
+     *         reporting InvalidLength, if the carried bytes cannot be encoded.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    std::string_view finish()
+    {
+        m_strBuffer.resize(m_Codec.encoded_size(m_szCarry));
+        size_t szOut = m_Codec.encode(m_au8Carry, m_szCarry, m_strBuffer.data());
+        if ((m_szCarry > 0) && (0 == szOut) && m_result) {
+            m_result.eStatus = BaseNStatus::InvalidLength;
+            m_result.szErrorOffset = m_szStreamPos - m_szCarry;
+        }
+        m_result.szWritten += szOut;
+        m_szCarry = 0;
+        m_bFinished = true;
+
+        return std::string_view(m_strBuffer.data(), szOut);
+
+    } /* finish() */
+
+
+    /**
+     * @brief Returns the outcome of the current (or last finished) stream: status, characters written, error offset.
+     */
+    const BaseNResult& result() const noexcept { return m_result; }
+
+
+private:
+
+    Codec m_Codec;                          ///< Codec settings.
+    std::string m_strBuffer;                ///< Output buffer reused across updates.
+    uint8_t m_au8Carry[Codec::szInBlock];   ///< Bytes of the incomplete group.
+    size_t m_szCarry = 0;                   ///< Number of carried bytes.
+    BaseNResult m_result;                   ///< Outcome of the current stream.
+    size_t m_szStreamPos = 0;               ///< Number of bytes received in the current stream.
+    bool m_bFinished = false;               ///< True once finish() was called, the next update() restarts.
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @class BaseNDecoder
+ * @brief Incremental decoder with constant memory, the counterpart of hexutils::HexDecoder.
+ *
+ * Characters which do not fill a whole group are carried over to the next update(). Once an error is
+ * detected the decoder stops, and result() reports the status and the offending offset counted from the
+ * start of the stream (whitespace excluded when it is skipped).
+ *
+ * @tparam Codec Base64Codec, Base32Codec or Base85Codec.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Codec>
+class BaseNDecoder
+{
+public:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Constructs a decoder.
+     * @param codec The codec settings.
+     * @param bSkipWhitespace If true, whitespace in the input is ignored (e.g. MIME line breaks).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    explicit BaseNDecoder(Codec codec = {}, bool bSkipWhitespace = false)
+        : m_Codec(codec)
+        , m_bSkipWhitespace(bSkipWhitespace)
+    {}
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Decodes the next chunk of input.
+     * @param chunk The input characters.
+     * @return The bytes of all the groups completed so far, valid until the next call on this decoder.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    std::span<const uint8_t> update(std::string_view chunk)
+    {
+        if (m_bFinished) {
+            m_reset();
+        }
+
+        return m_decode(chunk, false);
+
+    } /* update() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Decodes the carried characters as the final group; the next update() starts a new stream.
+     * @param pTail Optional, receives the bytes of the final group (valid until the next call on this decoder).
+     * @return True if the whole stream was valid, false otherwise.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    bool finish(std::span<const uint8_t>* pTail = nullptr)
+    {
+        std::span<const uint8_t> tail = m_decode(std::string_view(), true);
+        if (nullptr != pTail) {
+            *pTail = tail;
+        }
+        m_bFinished = true;
+
+        return static_cast<bool>(m_result);
+
+    } /* finish() */
+
+
+    /**
+     * @brief Returns the outcome of the current (or last finished) stream: status, bytes written, error offset.
+     */
+    const BaseNResult& result() const noexcept { return m_result; }
+
+
+private:
+
+    static bool is_whitespace(char c) noexcept
+    {
+        return (' ' == c) || ('\n' == c) || ('\r' == c) || ('\t' == c);
+    }
+
+    std::span<const uint8_t> m_decode(std::string_view chunk, bool bFinal)
+    {
+        if (!m_result) {
+            return {};
+        }
+
+        /* the carried characters and the new chunk form the input of this step */
+        std::string_view input = chunk;
+        if (!m_strWork.empty() || m_bSkipWhitespace) {
+            m_strWork.reserve(m_strWork.size() + chunk.size());
+            for (char c : chunk) {
+                if (!m_bSkipWhitespace || !is_whitespace(c)) {
+                    m_strWork.push_back(c);
+                }
+            }
+            input = m_strWork;
+        }
+
+        if (m_bEnded && !input.empty()) {
+            m_result.eStatus = BaseNStatus::InvalidPadding;
+            m_result.szErrorOffset = m_szStreamPos;
+            return {};
+        }
+
+        m_vBuffer.resize(m_Codec.decoded_size(input));
+        size_t szConsumed = 0;
+        BaseNResult step = m_Codec.decode(input, std::span<uint8_t>(m_vBuffer), bFinal, szConsumed);
+
+        m_result.szWritten += step.szWritten;
+        if (!step) {
+            m_result.eStatus = step.eStatus;
+            m_result.szErrorOffset = m_szStreamPos + step.szErrorOffset;
+        } else if ((szConsumed > 0) && m_Codec.is_final_group(input[szConsumed - 1])) {
+            m_bEnded = true;
+        }
+
+        m_szStreamPos += szConsumed;
+        m_strWork.assign(input.substr(szConsumed));
+
+        return std::span<const uint8_t>(m_vBuffer.data(), step.szWritten);
+    }
+
+    void m_reset()
+    {
+        m_result = BaseNResult{};
+        m_strWork.clear();
+        m_szStreamPos = 0;
+        m_bEnded = false;
+        m_bFinished = false;
+    }
+
+    Codec m_Codec;                   ///< Codec settings.
+    std::string m_strWork;           ///< Carried characters, followed by the filtered chunk when needed.
+    std::vector<uint8_t> m_vBuffer;  ///< Output buffer reused across updates.
+    BaseNResult m_result;            ///< Outcome of the current stream.
+    size_t m_szStreamPos = 0;        ///< Stream offset of the first carried character.
+    bool m_bEnded = false;           ///< True once a padded group was decoded.
+    bool m_bFinished = false;        ///< True once finish() was called, the next update() restarts.
+    bool m_bSkipWhitespace = false;  ///< True if whitespace is ignored.
+};
+
+} // namespace basenutils
+
+#endif // UBASENUTILS_HPP
@@ -1,7 +1,8 @@
 #ifndef UFILE_VIEWER_HPP
 #define UFILE_VIEWER_HPP
 
-#include "uFlagParser.hpp"
+#include "uHexdumpUtils.hpp"
+#include "uHexdumpDiff.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -10,40 +11,197 @@
 #include <vector>
 #include <iomanip>
 #include <cstddef>
+#include <cstdint>
 #include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined(_WIN32)
+    #include <io.h>
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <poll.h>
+    #if defined(__linux__)
+        #include <sys/inotify.h>
+    #endif
+#endif
+
+
+#ifndef uFILEVIEWER_USE_COLORS
+#define uFILEVIEWER_USE_COLORS   1U
+#endif
+
+#if (1 == uFILEVIEWER_USE_COLORS)
+#define uFILEVIEWER_ERROR_COLOR   "\033[91m"    // Bright Red
+#define uFILEVIEWER_OFFSET_COLOR  "\033[92m"    // Bright Green
+#define uFILEVIEWER_HEX_COLOR     "\033[96m"    // Bright Cyan
+#define uFILEVIEWER_ASCII_COLOR   "\033[97m"    // Bright White
+#define uFILEVIEWER_RESET_COLOR   "\033[0m"     // Reset to default
+#else
+#define uFILEVIEWER_ERROR_COLOR   ""
+#define uFILEVIEWER_OFFSET_COLOR  ""
+#define uFILEVIEWER_HEX_COLOR     ""
+#define uFILEVIEWER_ASCII_COLOR   ""
+#define uFILEVIEWER_RESET_COLOR   ""
+#endif // (1 == uFILEVIEWER_USE_COLORS)
 
+#ifndef uFILEVIEWER_LINE_INDEX_STRIDE
+#define uFILEVIEWER_LINE_INDEX_STRIDE   1024U   // Lines between two entries of the line index
+#endif
 
-#define uHEXDUMP_USE_COLORS   1U
+#ifndef uFILEVIEWER_FOLLOW_POLL_MS
+#define uFILEVIEWER_FOLLOW_POLL_MS      250U    // Size checks of the follow mode without inotify
+#endif
 
-#if (1 == uHEXDUMP_USE_COLORS)
-#define uHEXDUMP_ERROR_COLOR   "\033[91m"    // Bright Red
-#define uHEXDUMP_OFFSET_COLOR  "\033[92m"    // Bright Green
-#define uHEXDUMP_HEX_COLOR     "\033[96m"    // Bright Cyan
-#define uHEXDUMP_ASCII_COLOR   "\033[97m"    // Bright White
-#define uHEXDUMP_RESET_COLOR   "\033[0m"     // Reset to default
-#else
-#define uHEXDUMP_OFFSET_COLOR  ""
-#define uHEXDUMP_HEX_COLOR     ""
-#define uHEXDUMP_ASCII_COLOR   ""
-#define uHEXDUMP_RESET_COLOR   ""
-#endif // (1 == uHEXDUMP_USE_COLORS)
+#define uFILEVIEWER_LINE_INDEX_SUFFIX   ".lineidx"
+#define uFILEVIEWER_LINE_INDEX_MAGIC    "uFVLIDX1"
 
 /**
  * Concatenates two arguments and appends a reset color code for formatted output.
  */
-#define FRMT(a, b) a b uHEXDUMP_RESET_COLOR
+#define uFILEVIEWER_FRMT(a, b) a b uFILEVIEWER_RESET_COLOR
+
+/**
+ * Picks the colored or the plain variant of a format string.
+ */
+#define uFILEVIEWER_CFMT(bColors, a, b) ((bColors) ? uFILEVIEWER_FRMT(a, b) : b)
+
+/**
+ * Read-only memory mapping of a whole regular file, hinted for sequential reading.
+ * Empty files and files which cannot be mapped (pipes, devices) leave it invalid.
+ */
+class uFileMapping
+{
+    public:
+
+        uFileMapping() = default;
+
+        explicit uFileMapping(const std::string& filename)
+        {
+            open(filename);
+        }
+
+        ~uFileMapping()
+        {
+            close();
+        }
+
+        uFileMapping(const uFileMapping&) = delete;
+        uFileMapping& operator=(const uFileMapping&) = delete;
+
+        bool open(const std::string& filename)
+        {
+            close();
+#if defined(_WIN32)
+            HANDLE hFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (INVALID_HANDLE_VALUE == hFile) {
+                return false;
+            }
+            LARGE_INTEGER liSize;
+            if (GetFileSizeEx(hFile, &liSize) && (liSize.QuadPart > 0)) {
+                HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (nullptr != hMapping) {
+                    void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+                    if (nullptr != pView) {
+                        m_pData = static_cast<const uint8_t*>(pView);
+                        m_szSize = static_cast<std::size_t>(liSize.QuadPart);
+                    }
+                    CloseHandle(hMapping);
+                }
+            }
+            CloseHandle(hFile);
+#else
+            int iFd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            if (iFd < 0) {
+                return false;
+            }
+            struct stat fileStat;
+            if ((0 == fstat(iFd, &fileStat)) && S_ISREG(fileStat.st_mode) && (fileStat.st_size > 0)) {
+                const std::size_t szSize = static_cast<std::size_t>(fileStat.st_size);
+                void* pMap = mmap(nullptr, szSize, PROT_READ, MAP_PRIVATE, iFd, 0);
+                if (MAP_FAILED != pMap) {
+                    madvise(pMap, szSize, MADV_SEQUENTIAL);
+                    m_pData = static_cast<const uint8_t*>(pMap);
+                    m_szSize = szSize;
+                }
+            }
+            ::close(iFd);
+#endif
+            return valid();
+        }
+
+        void close()
+        {
+            if (nullptr != m_pData) {
+#if defined(_WIN32)
+                UnmapViewOfFile(m_pData);
+#else
+                munmap(const_cast<uint8_t*>(m_pData), m_szSize);
+#endif
+                m_pData = nullptr;
+                m_szSize = 0;
+            }
+        }
+
+        bool valid() const { return nullptr != m_pData; }
+        const uint8_t* data() const { return m_pData; }
+        std::size_t size() const { return m_szSize; }
+
+    private:
+
+        const uint8_t* m_pData = nullptr;
+        std::size_t m_szSize = 0;
 
+};
+
+/**
+ * Text and hex views of a file. The views share one file stream (its position moves with every read), so
+ * a viewer must not be used from several threads at once, stopFollow() excepted; use one viewer per thread.
+ */
 class uFileViewer
 {
     public:
 
-        explicit uFileViewer(const std::string& filename )
+        /**
+         * With bMemoryMapped the views read the file through a memory mapping: the mapped bytes go
+         * to the formatter without copies or per-chunk reads. Files which cannot be mapped are read as usual.
+         */
+        explicit uFileViewer(const std::string& filename, bool bMemoryMapped = false )
         : m_File(filename, std::ios::binary)
+        , m_strFilename(filename)
         {
+#if defined(_WIN32)
+            m_bColors = (0 != _isatty(_fileno(stdout)));
+#else
+            m_bColors = (1 == isatty(fileno(stdout)));
+#endif
             if (!m_File) {
-                std::printf(FRMT(uHEXDUMP_ERROR_COLOR, "Error: Could not open file: %s\n"), filename.c_str());
+                std::printf(uFILEVIEWER_CFMT(m_bColors, uFILEVIEWER_ERROR_COLOR, "Error: Could not open file: %s\n"), filename.c_str());
                 m_bValid = false;
             }
+            if (m_bValid && bMemoryMapped) {
+                m_Mapping.open(filename);
+            }
+        }
+
+        /**
+         * True when the views read the file through a memory mapping.
+         */
+        bool isMapped() const
+        {
+            return m_Mapping.valid();
         }
 
         ~uFileViewer()
@@ -51,121 +209,787 @@ class uFileViewer
             if (m_File.is_open()) {
                 m_File.close();
             }
+#if !defined(_WIN32)
+            if (m_aiWakePipe[0] >= 0) {
+                ::close(m_aiWakePipe[0]);
+                ::close(m_aiWakePipe[1]);
+            }
+#endif
+        }
+
+        /**
+         * Forces the color escapes on or off (by default they are on when stdout is a terminal).
+         */
+        void setColors(bool bColors)
+        {
+            m_bColors = bColors;
         }
 
+        /**
+         * Prints the whole file as text, every line in the text color.
+         */
         void show() const
         {
             if (!m_bValid) return;
 
-            std::string line;
-            while (std::getline(m_File, line)) {
-                std::printf(FRMT(uHEXDUMP_ASCII_COLOR, "%s\n"), line.c_str());
+            LineWriter writer(m_bColors);
+            forEachBlock(0, [&writer](const char* pData, std::size_t szLen) {
+                writer.write(pData, szLen);
+                return true;
+            });
+        }
+
+        /**
+         * Prints szCount lines from line szFrom (counted from 0). With a line index (see buildLineIndex())
+         * the reading starts at the closest indexed line before szFrom, otherwise at the start of the file.
+         * An index built before the file changed size or modification time is not used.
+         */
+        void showLines(std::size_t szFrom, std::size_t szCount) const
+        {
+            if (!m_bValid || (0 == szCount)) return;
+
+            std::size_t szLine = 0;
+            std::size_t szOffset = 0;
+            if (lineIndexValid()) {
+                const std::size_t szEntry = std::min(szFrom / uFILEVIEWER_LINE_INDEX_STRIDE, m_vLineIndex.size() - 1);
+                szLine = szEntry * uFILEVIEWER_LINE_INDEX_STRIDE;
+                szOffset = static_cast<std::size_t>(m_vLineIndex[szEntry]);
+            }
+
+            LineWriter writer(m_bColors);
+            forEachBlock(szOffset, [&](const char* pData, std::size_t szLen) {
+                const char* const pEnd = pData + szLen;
+                // skip up to line szFrom
+                while ((szLine < szFrom) && (pData < pEnd)) {
+                    const char* pNewline = static_cast<const char*>(std::memchr(pData, '\n', static_cast<std::size_t>(pEnd - pData)));
+                    if (nullptr == pNewline) {
+                        return true;
+                    }
+                    pData = pNewline + 1;
+                    ++szLine;
+                }
+                // print up to szCount lines
+                const char* pStart = pData;
+                while ((szCount > 0) && (pData < pEnd)) {
+                    const char* pNewline = static_cast<const char*>(std::memchr(pData, '\n', static_cast<std::size_t>(pEnd - pData)));
+                    if (nullptr == pNewline) {
+                        pData = pEnd;
+                        break;
+                    }
+                    pData = pNewline + 1;
+                    --szCount;
+                }
+                writer.write(pStart, static_cast<std::size_t>(pData - pStart));
+                return szCount > 0;
+            });
+        }
+
+        /**
+         * Prints the last szCount lines, reading the file backwards from its end: the cost depends on the
+         * lines printed, not on the size of the file.
+         */
+        void tail(std::size_t szCount = 10) const
+        {
+            if (!m_bValid || (0 == szCount)) return;
+
+            const std::size_t szSize = fileSize();
+            const std::size_t szStart = tailStart(szCount, szSize);
+
+            LineWriter writer(m_bColors);
+            forEachBlock(szStart, [&writer](const char* pData, std::size_t szLen) {
+                writer.write(pData, szLen);
+                return true;
+            }, szSize - szStart);
+        }
+
+        /**
+         * Builds the sparse line index used by showLines(): the offset of every uFILEVIEWER_LINE_INDEX_STRIDE-th
+         * line. With bCache the index is also loaded from, or saved to, the file name plus uFILEVIEWER_LINE_INDEX_SUFFIX
+         * (a file written next to the viewed one); a cached index is used only if the size and the modification
+         * time of the file did not change. Returns the number of lines of the file.
+         */
+        std::size_t buildLineIndex(bool bCache = false)
+        {
+            if (!m_bValid) return 0;
+
+            const std::string strCache = m_strFilename + uFILEVIEWER_LINE_INDEX_SUFFIX;
+            const std::size_t szSize = fileSize();
+            const int64_t i64Time = fileTime();
+            m_szIndexSize = szSize;
+            m_i64IndexTime = i64Time;
+
+            if (bCache && loadLineIndex(strCache, szSize, i64Time)) {
+                return m_szLineCount;
             }
+
+            m_vLineIndex.assign(1, 0);
+            m_szLineCount = 0;
+            std::size_t szOffset = 0;
+            char cLast = '\n';
+            forEachBlock(0, [&](const char* pData, std::size_t szLen) {
+                const char* const pEnd = pData + szLen;
+                for (const char* p = pData; (p = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(pEnd - p)))) != nullptr; ++p) {
+                    if (0 == (++m_szLineCount % uFILEVIEWER_LINE_INDEX_STRIDE)) {
+                        m_vLineIndex.push_back(szOffset + static_cast<std::size_t>(p - pData) + 1);
+                    }
+                }
+                szOffset += szLen;
+                cLast = pData[szLen - 1];
+                return true;
+            });
+            // a last line without newline
+            m_szLineCount += ('\n' != cLast) ? 1 : 0;
+
+            if (bCache) {
+                saveLineIndex(strCache, szSize, i64Time);
+            }
+            return m_szLineCount;
+        }
+
+        /**
+         * Number of lines of the file, building the line index (without cache) if there is none or the file changed.
+         */
+        std::size_t lineCount()
+        {
+            return lineIndexValid() ? m_szLineCount : buildLineIndex(false);
         }
 
-        void showhex(std::size_t szBytesPerLine = 16, const std::string& flagString = "", std::size_t szShowOffset = 0, std::size_t szChunkSize = 1024 )
+        /**
+         * Follow mode (as tail -f): prints the last szInitialLines lines, then the text appended to the file,
+         * until stopFollow() is called. The appended bytes are read from the last position only, when inotify
+         * reports a change (Linux) or when a size check every uFILEVIEWER_FOLLOW_POLL_MS ms finds them. A
+         * truncated file is followed again from its start.
+         */
+        void followText(std::size_t szInitialLines = 10)
         {
             if (!m_bValid) return;
+            m_bStopFollow.store(false);     // cleared here only, so a stop landing while the follow ends is kept
+
+            const std::size_t szSize = fileSize();
+            const std::size_t szStart = (0 == szInitialLines) ? szSize : tailStart(szInitialLines, szSize);
+
+            LineWriter writer(m_bColors);
+            forEachBlock(szStart, [&writer](const char* pData, std::size_t szLen) {
+                writer.write(pData, szLen);
+                return true;
+            }, szSize - szStart);
+            writer.flush();
+
+            followAppends(szSize, [&writer](const char* pData, std::size_t szLen, std::size_t /*szOffset*/) {
+                writer.write(pData, szLen);
+            }, [&writer]() {
+                writer.flush();
+            });
+        }
+
+        /**
+         * Follow mode of the hex view: the bytes appended to the file are dumped as showhex() does, the
+         * offsets continuing from the previous position; with bFromStart the bytes already in the file are
+         * dumped first. A line is printed once complete (with a squeeze flag, once the byte after it arrived);
+         * the last partial line is printed by stopFollow(). Runs until stopFollow() is called.
+         */
+        void followHex(std::size_t szBytesPerLine = 16, const std::string& flagString = "", bool bFromStart = false)
+        {
+            if (!m_bValid) return;
+            m_bStopFollow.store(false);     // cleared here only, so a stop landing while the follow ends is kept
+
+            hexutils::HexDumpOptions options;
+            if (!hexOptions(szBytesPerLine, flagString, options)) {
+                return;
+            }
+            hexutils::HexDumpRenderer renderer(options);
+            const std::size_t szBpl = renderer.bytes_per_line();
+            if (0 == szBpl) {
+                return;
+            }
+
+            // as in showhex(): two lines already shown in front of the lines not shown yet
+            std::vector<uint8_t> buffer;
+            std::size_t szHistory = 0;
+            std::size_t szBufferOffset = bFromStart ? 0 : fileSize();
+            std::string text;
+
+            auto fnShow = [&](bool bAll) {
+                const std::size_t szTotal = buffer.size();
+                std::size_t szEnd = szTotal;
+                if (!bAll) {
+                    const std::size_t szLines = options.bSqueeze ? (std::max(szTotal, szHistory + 1) - szHistory - 1) / szBpl : (szTotal - szHistory) / szBpl;
+                    szEnd = szHistory + szLines * szBpl;
+                }
+                text.clear();
+                renderer.set_base_offset(szBufferOffset);
+                renderer.render_into(buffer.data(), szTotal, text, szHistory, szEnd);
+                std::fwrite(text.data(), 1, text.size(), stdout);
+
+                const std::size_t szKeep = std::min(szEnd, 2 * szBpl);
+                buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(szEnd - szKeep));
+                szBufferOffset += szEnd - szKeep;
+                szHistory = szKeep;
+            };
+
+            followAppends(szBufferOffset, [&](const char* pData, std::size_t szLen, std::size_t szOffset) {
+                if (szOffset != szBufferOffset + buffer.size()) {
+                    // truncated: start over
+                    buffer.clear();
+                    szHistory = 0;
+                    szBufferOffset = szOffset;
+                }
+                buffer.insert(buffer.end(), pData, pData + szLen);
+                if (buffer.size() - szHistory >= 256 * 1024) {
+                    fnShow(false);
+                }
+            }, [&]() {
+                fnShow(false);
+                std::fflush(stdout);
+            });
+
+            fnShow(true);
+            std::fflush(stdout);
+        }
+
+        /**
+         * Ends followText() or followHex(), from another thread or from a signal handler (it only stores a
+         * flag and writes to a pipe). It ends the follow running, or one which has started; a stop requested before
+         * followText() or followHex() is called is cleared by it.
+         */
+        void stopFollow()
+        {
+            m_bStopFollow.store(true);
+#if !defined(_WIN32)
+            const int iWake = m_iWakeWrite.load();
+            if (iWake >= 0) {
+                const char cWake = 0;
+                [[maybe_unused]] const ssize_t iWritten = ::write(iWake, &cWake, 1);
+            }
+#endif
+        }
+
+        /**
+         * Dumps szShowLength bytes (by default up to the end of the file) from szShowOffset. The offsets shown
+         * count from szShowOffset, or with bAbsoluteOffsets from the start of the file. Only the requested range
+         * is read, in reads of szChunkSize bytes rounded down to whole lines; the output does not depend on the
+         * chunk size.
+         */
+        void showhex(std::size_t szBytesPerLine = 16, const std::string& flagString = "", std::size_t szShowOffset = 0, std::size_t szChunkSize = 256 * 1024, std::size_t szShowLength = SIZE_MAX, bool bAbsoluteOffsets = false )
+        {
+            if (!m_bValid) return;
+
+            hexutils::HexDumpOptions options;
+            if (!hexOptions(szBytesPerLine, flagString, options)) {
+                return;
+            }
+
+            hexutils::HexDumpRenderer renderer(options);
+            const std::size_t szBpl = renderer.bytes_per_line();
+            if (0 == szBpl) {
+                return;
+            }
+
+            if (m_Mapping.valid()) {
+                if (szShowOffset < m_Mapping.size()) {
+                    renderer.set_base_offset(bAbsoluteOffsets ? szShowOffset : 0);
+                    renderer.dump(m_Mapping.data() + szShowOffset, std::min(szShowLength, m_Mapping.size() - szShowOffset));
+                }
+                return;
+            }
 
             m_File.clear(); // Clear any error flags
             m_File.seekg(szShowOffset, std::ios::beg);
 
-            bool bShowSpaces = true;
-            bool bShowAscii = true;
-            bool bShowOffset = true;
-            bool bDecimalOffset = false;
-
-            if(!flagString.empty()) {
-                try {
-                    FlagParser flags(flagString);
-
-                    if (flagString.find_first_of("sS") != std::string::npos)
-                        bShowSpaces = flags.get_flag('S');
-                    if (flagString.find_first_of("aA") != std::string::npos)
-                        bShowAscii = flags.get_flag('A');
-                    if (flagString.find_first_of("oO") != std::string::npos)
-                        bShowOffset = flags.get_flag('O');
-                    if (flagString.find_first_of("dD") != std::string::npos)
-                        bDecimalOffset = flags.get_flag('D');
-                } catch (const std::exception& e) {
-                    std::printf(FRMT(uHEXDUMP_ERROR_COLOR, "Error: Invalid flag string: %s\n"), e.what());
-                    return;
+            // One buffer for the whole dump: two lines already shown (a squeezed run looks back at them), the
+            // lines not shown yet, then the next read. A line is shown once the byte after it was read, so
+            // the lines and the squeezed runs come out as from a single dump of the range.
+            const std::size_t szHistoryMax = 2 * szBpl;
+            const std::size_t szReadSize = std::max(szChunkSize - szChunkSize % szBpl, szBpl);
+            std::vector<uint8_t> buffer(szHistoryMax + szBpl + szReadSize);
+            std::string text;
+            std::size_t szHistory = 0;              // bytes shown, kept at the front of the buffer
+            std::size_t szPending = 0;              // bytes read, not shown yet, after the history
+            std::size_t szBufferOffset = bAbsoluteOffsets ? szShowOffset : 0;  // offset shown for the front of the buffer
+            std::size_t szRemaining = szShowLength;
+            bool bEnd = false;
+
+            while (!bEnd) {
+                const std::size_t szFree = std::min(buffer.size() - szHistory - szPending, szRemaining);
+                std::size_t szRead = 0;
+                if (szFree > 0) {
+                    m_File.read(reinterpret_cast<char*>(buffer.data() + szHistory + szPending), static_cast<std::streamsize>(szFree));
+                    szRead = static_cast<std::size_t>(std::max<std::streamsize>(m_File.gcount(), 0));
                 }
+                szRemaining -= szRead;
+                bEnd = (szRead < szFree) || (0 == szRemaining) || !m_File;
+
+                const std::size_t szTotal = szHistory + szPending + szRead;
+                std::size_t szEnd = szTotal;
+                if (!bEnd) {
+                    szEnd = szHistory + ((szTotal - szHistory - 1) / szBpl) * szBpl;
+                }
+
+                text.clear();
+                renderer.set_base_offset(szBufferOffset);
+                renderer.render_into(buffer.data(), szTotal, text, szHistory, szEnd);
+                std::fwrite(text.data(), 1, text.size(), stdout);
+
+                const std::size_t szKeep = std::min(szEnd, szHistoryMax);
+                std::memmove(buffer.data(), buffer.data() + szEnd - szKeep, szTotal - szEnd + szKeep);
+                szBufferOffset += szEnd - szKeep;
+                szHistory = szKeep;
+                szPending = szTotal - szEnd;
+            }
+        }
+
+        /**
+         * Sets the layout of the pages shown by page(): szLinesPerPage lines of szBytesPerLine bytes (at most
+         * 96, as in showhex()), with the flags of showhex().
+         */
+        void setPage(std::size_t szBytesPerLine, std::size_t szLinesPerPage, const std::string& flagString = "")
+        {
+            // a page is whole lines of the dump, so it has the line size the renderer will use
+            m_szPageBytesPerLine = std::clamp<std::size_t>(szBytesPerLine, 1, hexutils::internal::g_szHexDumpMaxBytesPerLine2);
+            m_szPageLines = std::max<std::size_t>(szLinesPerPage, 1);
+            m_strPageFlags = flagString;
+        }
+
+        /**
+         * Number of pages of the file (the last one may be partial), in the layout of setPage().
+         */
+        std::size_t pageCount() const
+        {
+            const std::size_t szPageSize = m_szPageBytesPerLine * m_szPageLines;
+            return (fileSize() + szPageSize - 1) / szPageSize;
+        }
+
+        /**
+         * Dumps the page szPage (counted from 0) with the offsets of the file, reading only its bytes (one seek
+         * and read of the shared stream, or the mapping; not thread-safe, see the class). Returns false past
+         * the last page.
+         */
+        bool page(std::size_t szPage)
+        {
+            if (!m_bValid || (szPage >= pageCount())) {
+                return false;
             }
 
-            std::vector<char> buffer(szChunkSize);
-            size_t szCrtOffset = 0;
+            const std::size_t szPageSize = m_szPageBytesPerLine * m_szPageLines;
+            showhex(m_szPageBytesPerLine, m_strPageFlags, szPage * szPageSize, szPageSize, szPageSize, true);
+            return true;
+        }
+
+        /**
+         * Prints side by side the lines where this file and strOtherFile differ, followed by a summary,
+         * and returns the statistics of the diff. Both files are read in chunks of szChunkSize bytes
+         * (rounded down to whole lines), so their size is not bounded by the memory.
+         */
+        hexutils::HexDiffStats showdiff(const std::string& strOtherFile, std::size_t szBytesPerLine = 16, const std::string& flagString = "", std::size_t szChunkSize = 1024 * 1024 )
+        {
+            hexutils::HexDiffStats stats;
+            if (!m_bValid) return stats;
+
+            std::ifstream otherFile(strOtherFile, std::ios::binary);
+            if (!otherFile) {
+                std::printf(uFILEVIEWER_CFMT(m_bColors, uFILEVIEWER_ERROR_COLOR, "Error: Could not open file: %s\n"), strOtherFile.c_str());
+                return stats;
+            }
+
+            m_File.clear(); // Clear any error flags
+            m_File.seekg(0, std::ios::beg);
+
+            hexutils::HexDumpOptions options;
+            if (!hexOptions(szBytesPerLine, flagString, options)) {
+                return stats;
+            }
 
-            while (m_File) {
-                m_File.read(buffer.data(), szChunkSize);
-                std::streamsize bytesRead = m_File.gcount();
-                if (bytesRead > 0) {
-                    buffer.resize(static_cast<size_t>(bytesRead)); // Resize buffer to actual bytes read
-                    m_HexDumpSection(buffer, szCrtOffset, szBytesPerLine, bShowSpaces, bShowAscii, bShowOffset, bDecimalOffset);
-                    szCrtOffset += static_cast<size_t>(bytesRead);
+            // whole lines per chunk, so the lines keep their offsets from one chunk to the next
+            const std::size_t szBpl = std::max<std::size_t>(options.szBytesPerLine, 1);
+            szChunkSize = std::max(szChunkSize - szChunkSize % szBpl, szBpl);
+
+            hexutils::HexDiffer differ(options);
+            uFileMapping otherMapping;
+
+            if (m_Mapping.valid() && otherMapping.open(strOtherFile)) {
+                differ.update(m_Mapping.data(), m_Mapping.size(), otherMapping.data(), otherMapping.size(), hexutils::HexDumpFileSink(stdout));
+            } else {
+                std::vector<char> bufferA(szChunkSize);
+                std::vector<char> bufferB(szChunkSize);
+
+                while (true) {
+                    m_File.read(bufferA.data(), szChunkSize);
+                    otherFile.read(bufferB.data(), szChunkSize);
+                    const std::streamsize bytesReadA = m_File.gcount();
+                    const std::streamsize bytesReadB = otherFile.gcount();
+                    if ((bytesReadA <= 0) && (bytesReadB <= 0)) {
+                        break;
+                    }
+                    differ.update(reinterpret_cast<const uint8_t*>(bufferA.data()), static_cast<size_t>(std::max<std::streamsize>(bytesReadA, 0)),
+                                  reinterpret_cast<const uint8_t*>(bufferB.data()), static_cast<size_t>(std::max<std::streamsize>(bytesReadB, 0)),
+                                  hexutils::HexDumpFileSink(stdout));
                 }
             }
+
+            stats = differ.stats();
+            if (stats.identical()) {
+                std::printf(uFILEVIEWER_CFMT(m_bColors, uFILEVIEWER_OFFSET_COLOR, "Files are identical (%zu bytes)\n"), stats.szCompared);
+            } else {
+                std::printf(uFILEVIEWER_CFMT(m_bColors, uFILEVIEWER_ERROR_COLOR, "%zu of %zu bytes differ in %zu regions, first at offset %zu\n"),
+                            stats.szDiffBytes, stats.szCompared, stats.szRegions, stats.szFirstDiff);
+            }
+            return stats;
         }
 
     private:
 
-        void m_HexDumpSection(const std::vector<char>& data, size_t szCrtOffset, size_t szBytesPerLine = 16, bool bShowSpaces = true, bool bShowAscii = true, bool bShowOffset = true, bool bDecimalOffset = false)
+        /**
+         * Buffers text for stdout: with colors every line is wrapped in the text color, a last line
+         * without newline gets one (as show() always printed them).
+         */
+        class LineWriter
         {
-            if (szBytesPerLine > 96) {
-                szBytesPerLine = 96;
-            }
+            public:
 
-            size_t szOffset =szCrtOffset;
-            size_t szDataSize = data.size();
-            size_t szLines = szDataSize / szBytesPerLine;
-            size_t szLastLineLen = szDataSize % szBytesPerLine;
+                explicit LineWriter(bool bColors) : m_bColors(bColors)
+                {
+                    m_strOut.reserve(kFlushSize + 256);
+                }
 
-            if (szLastLineLen != 0) ++szLines;
+                ~LineWriter()
+                {
+                    if (!m_bAtLineStart) {
+                        write("\n", 1);
+                    }
+                    flush();
+                }
 
-            char buffer[288];  // Shared buffer for all sections max 96
+                LineWriter(const LineWriter&) = delete;
+                LineWriter& operator=(const LineWriter&) = delete;
 
-            for (size_t i = 0; i < szLines; ++i) {
-                size_t szLineStart = i * szBytesPerLine;
-                size_t szLineLen = (i == szLines - 1 && szLastLineLen != 0) ? szLastLineLen : szBytesPerLine;
+                void flush()
+                {
+                    std::fwrite(m_strOut.data(), 1, m_strOut.size(), stdout);
+                    std::fflush(stdout);
+                    m_strOut.clear();
+                }
 
-                /*  Offset */
-                if (bShowOffset) {
-                    if (bDecimalOffset) {
-                        snprintf(buffer, sizeof(buffer), "%08zu | ", szOffset + szLineStart);
+                void write(const char* pData, std::size_t szLen)
+                {
+                    if (0 == szLen) {
+                        return;
+                    }
+                    if (!m_bColors) {
+                        m_strOut.append(pData, szLen);
+                        m_bAtLineStart = ('\n' == pData[szLen - 1]);
                     } else {
-                        snprintf(buffer, sizeof(buffer), "%08zX | ", szOffset + szLineStart);
+                        const char* const pEnd = pData + szLen;
+                        while (pData < pEnd) {
+                            if (m_bAtLineStart) {
+                                m_strOut.append(uFILEVIEWER_ASCII_COLOR);
+                            }
+                            const char* pNewline = static_cast<const char*>(std::memchr(pData, '\n', static_cast<std::size_t>(pEnd - pData)));
+                            const char* pLineEnd = (nullptr != pNewline) ? pNewline + 1 : pEnd;
+                            m_strOut.append(pData, pLineEnd);
+                            if (nullptr != pNewline) {
+                                m_strOut.append(uFILEVIEWER_RESET_COLOR);
+                            }
+                            m_bAtLineStart = (nullptr != pNewline);
+                            pData = pLineEnd;
+                            if (m_strOut.size() >= kFlushSize) {
+                                flush();
+                            }
+                        }
+                    }
+                    if (m_strOut.size() >= kFlushSize) {
+                        flush();
                     }
-                    std::printf(FRMT(uHEXDUMP_OFFSET_COLOR, "%s"), buffer);
                 }
 
-                /* Hex values */
-                size_t pos = 0;
-                for (size_t j = 0; j < szBytesPerLine; ++j) {
-                    if (j < szLineLen) {
-                        pos += snprintf(buffer + pos, sizeof(buffer) - pos, bShowSpaces ? "%02X " : "%02X", static_cast<unsigned char>(data[szLineStart + j]));
-                    } else {
-                        pos += snprintf(buffer + pos, sizeof(buffer) - pos, bShowSpaces ? "   " : "  ");
+            private:
+
+                static constexpr std::size_t kFlushSize = 64 * 1024;
+
+                bool m_bColors;
+                bool m_bAtLineStart = true;
+                std::string m_strOut;
+        };
+
+        /**
+         * Hands szLength bytes of the file (by default up to its end) from szOffset to
+         * fnBlock(const char* pData, std::size_t szLen) in blocks (a single one when mapped), as long as
+         * fnBlock returns true.
+         */
+        template<typename BlockFn>
+        void forEachBlock(std::size_t szOffset, BlockFn&& fnBlock, std::size_t szLength = SIZE_MAX) const
+        {
+            if (m_Mapping.valid()) {
+                if ((szOffset < m_Mapping.size()) && (szLength > 0)) {
+                    fnBlock(reinterpret_cast<const char*>(m_Mapping.data()) + szOffset, std::min(szLength, m_Mapping.size() - szOffset));
+                }
+                return;
+            }
+
+            m_File.clear(); // Clear any error flags
+            m_File.seekg(static_cast<std::streamoff>(szOffset), std::ios::beg);
+            std::vector<char> buffer(256 * 1024);
+            while (m_File && (szLength > 0)) {
+                m_File.read(buffer.data(), static_cast<std::streamsize>(std::min(buffer.size(), szLength)));
+                const std::streamsize bytesRead = m_File.gcount();
+                if ((bytesRead <= 0) || !fnBlock(static_cast<const char*>(buffer.data()), static_cast<std::size_t>(bytesRead))) {
+                    break;
+                }
+                szLength -= static_cast<std::size_t>(bytesRead);
+            }
+        }
+
+        /**
+         * Offset of the first of the last szCount lines of the first szSize bytes, found reading backwards.
+         */
+        std::size_t tailStart(std::size_t szCount, std::size_t szSize) const
+        {
+            std::size_t szStart = 0;
+            std::size_t szNewlines = 0;
+            // the newline ending the last line does not start a line
+            const std::size_t szEnd = (szSize > 0) && ('\n' == byteAt(szSize - 1)) ? szSize - 1 : szSize;
+
+            std::vector<char> buffer(m_Mapping.valid() ? 0 : 64 * 1024);
+            for (std::size_t szBlockEnd = szEnd; (szBlockEnd > 0) && (0 == szStart); ) {
+                const char* pBlock = nullptr;
+                std::size_t szBlockLen = 0;
+                if (m_Mapping.valid()) {
+                    pBlock = reinterpret_cast<const char*>(m_Mapping.data());
+                    szBlockLen = szBlockEnd;
+                } else {
+                    szBlockLen = std::min(szBlockEnd, buffer.size());
+                    m_File.clear(); // Clear any error flags
+                    m_File.seekg(static_cast<std::streamoff>(szBlockEnd - szBlockLen), std::ios::beg);
+                    m_File.read(buffer.data(), static_cast<std::streamsize>(szBlockLen));
+                    if (m_File.gcount() != static_cast<std::streamsize>(szBlockLen)) {
+                        break;
+                    }
+                    pBlock = buffer.data();
+                }
+                const std::size_t szBlockStart = szBlockEnd - szBlockLen;
+                for (std::size_t szPos = szBlockLen; szPos > 0; --szPos) {
+                    if (('\n' == pBlock[szPos - 1]) && (++szNewlines == szCount)) {
+                        szStart = szBlockStart + szPos;
+                        break;
                     }
                 }
-                std::printf(FRMT(uHEXDUMP_HEX_COLOR, "%s"), buffer);
+                szBlockEnd = szBlockStart;
+            }
+
+            return szStart;
+        }
+
+        /**
+         * The loop of the follow modes: hands the bytes appended from szOffset to
+         * fnData(const char* pData, std::size_t szLen, std::size_t szOffset), then calls fnBatchEnd(), each
+         * time the file grows, until stopFollow(). Sleeps in poll() on inotify and on the wake pipe of
+         * stopFollow(); without inotify the size is checked every uFILEVIEWER_FOLLOW_POLL_MS ms.
+         */
+        template<typename DataFn, typename BatchEndFn>
+        void followAppends(std::size_t szOffset, DataFn&& fnData, BatchEndFn&& fnBatchEnd)
+        {
+            std::vector<char> buffer(256 * 1024);
+            auto fnReadAppended = [&]() {
+                const std::size_t szSize = streamSize();
+                if (szSize < szOffset) {
+                    szOffset = 0;
+                }
+                if (szSize == szOffset) {
+                    return;
+                }
+                // up to the size seen now, so a fast writer cannot keep the loop from checking for a stop
+                m_File.clear(); // Clear any error flags
+                m_File.seekg(static_cast<std::streamoff>(szOffset), std::ios::beg);
+                while (m_File && (szOffset < szSize)) {
+                    m_File.read(buffer.data(), static_cast<std::streamsize>(std::min(buffer.size(), szSize - szOffset)));
+                    const std::streamsize bytesRead = m_File.gcount();
+                    if (bytesRead <= 0) {
+                        break;
+                    }
+                    fnData(static_cast<const char*>(buffer.data()), static_cast<std::size_t>(bytesRead), szOffset);
+                    szOffset += static_cast<std::size_t>(bytesRead);
+                }
+                fnBatchEnd();
+            };
+
+#if defined(_WIN32)
+            // reads once more after a stop, so what was written before it is shown
+            while (fnReadAppended(), !m_bStopFollow.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(uFILEVIEWER_FOLLOW_POLL_MS));
+            }
+#else
+            if (m_aiWakePipe[0] < 0) {
+                if (0 == ::pipe(m_aiWakePipe)) {
+                    fcntl(m_aiWakePipe[0], F_SETFL, O_NONBLOCK);
+                    fcntl(m_aiWakePipe[1], F_SETFL, O_NONBLOCK);
+                    m_iWakeWrite.store(m_aiWakePipe[1]);
+                } else {
+                    m_aiWakePipe[0] = m_aiWakePipe[1] = -1;
+                }
+            }
+            // wake-ups of stops requested before this follow, which would keep poll() from sleeping
+            char acEvents[4096];
+            if (m_aiWakePipe[0] >= 0) {
+                while (::read(m_aiWakePipe[0], acEvents, sizeof(acEvents)) > 0) {
+                }
+            }
 
-                /* ASCII characters */
-                if (bShowAscii) {
-                    pos = 0;
-                    pos += snprintf(buffer + pos, sizeof(buffer) - pos, " | ");
-                    for (size_t j = 0; j < szLineLen; ++j) {
-                        uint8_t ch = static_cast<unsigned char>(data[szLineStart + j]);
-                        pos += snprintf(buffer + pos, sizeof(buffer) - pos, "%c", isprint(ch) ? ch : '.');
+            int iNotify = -1;
+    #if defined(__linux__)
+            iNotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if ((iNotify >= 0) && (inotify_add_watch(iNotify, m_strFilename.c_str(), IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE) < 0)) {
+                ::close(iNotify);
+                iNotify = -1;
+            }
+    #endif
+            // without inotify, or without the wake pipe, poll() has to wake up now and then
+            const int iTimeout = ((iNotify >= 0) && (m_aiWakePipe[0] >= 0)) ? -1 : static_cast<int>(uFILEVIEWER_FOLLOW_POLL_MS);
+
+            // reads once more after a stop, so what was written before it is shown
+            while (fnReadAppended(), !m_bStopFollow.load()) {
+                struct pollfd aFds[2] = {{m_aiWakePipe[0], POLLIN, 0}, {iNotify, POLLIN, 0}};
+                if ((poll(aFds, 2, iTimeout) > 0) && (0 != (aFds[1].revents & POLLIN))) {
+                    while (::read(iNotify, acEvents, sizeof(acEvents)) > 0) {
                     }
-                    std::printf(FRMT(uHEXDUMP_ASCII_COLOR, "%s"), buffer);
                 }
+            }
 
-                std::printf("\n");
+            if (iNotify >= 0) {
+                ::close(iNotify);
             }
+#endif
+        }
+
+        /**
+         * The byte at szOffset (which must be inside the file).
+         */
+        char byteAt(std::size_t szOffset) const
+        {
+            if (m_Mapping.valid()) {
+                return static_cast<char>(m_Mapping.data()[szOffset]);
+            }
+            char cByte = 0;
+            m_File.clear(); // Clear any error flags
+            m_File.seekg(static_cast<std::streamoff>(szOffset), std::ios::beg);
+            m_File.read(&cByte, 1);
+            return cByte;
+        }
+
+        /**
+         * Modification time of the file, 0 if it cannot be read.
+         */
+        int64_t fileTime() const
+        {
+            std::error_code ec;
+            return static_cast<int64_t>(std::filesystem::last_write_time(m_strFilename, ec).time_since_epoch().count());
+        }
+
+        /**
+         * True if there is a line index and the file has the size and modification time it was built for.
+         */
+        bool lineIndexValid() const
+        {
+            return !m_vLineIndex.empty() && (fileSize() == m_szIndexSize) && (fileTime() == m_i64IndexTime);
+        }
+
+        /**
+         * Loads a cached line index, if it was built for a file of this size and modification time.
+         */
+        bool loadLineIndex(const std::string& strCache, std::size_t szSize, int64_t i64Time)
+        {
+            std::ifstream cache(strCache, std::ios::binary);
+            char acMagic[8] = {};
+            uint64_t au64Header[4] = {};    // file size, modification time, stride, line count
+            uint64_t u64Entries = 0;
+            if (!cache.read(acMagic, sizeof(acMagic)) || (0 != std::memcmp(acMagic, uFILEVIEWER_LINE_INDEX_MAGIC, sizeof(acMagic))) ||
+                !cache.read(reinterpret_cast<char*>(au64Header), sizeof(au64Header)) ||
+                !cache.read(reinterpret_cast<char*>(&u64Entries), sizeof(u64Entries))) {
+                return false;
+            }
+            if ((au64Header[0] != szSize) || (au64Header[1] != static_cast<uint64_t>(i64Time)) ||
+                (au64Header[2] != uFILEVIEWER_LINE_INDEX_STRIDE) || (0 == u64Entries) ||
+                (u64Entries > au64Header[3] / uFILEVIEWER_LINE_INDEX_STRIDE + 1)) {
+                return false;
+            }
+            std::vector<uint64_t> vIndex(static_cast<std::size_t>(u64Entries));
+            if (!cache.read(reinterpret_cast<char*>(vIndex.data()), static_cast<std::streamsize>(vIndex.size() * sizeof(uint64_t)))) {
+                return false;
+            }
+            m_vLineIndex = std::move(vIndex);
+            m_szLineCount = static_cast<std::size_t>(au64Header[3]);
+            return true;
+        }
+
+        /**
+         * Saves the line index next to the file (silently skipped if the directory is not writable).
+         */
+        void saveLineIndex(const std::string& strCache, std::size_t szSize, int64_t i64Time) const
+        {
+            std::ofstream cache(strCache, std::ios::binary | std::ios::trunc);
+            const uint64_t au64Header[4] = {szSize, static_cast<uint64_t>(i64Time), uFILEVIEWER_LINE_INDEX_STRIDE, m_szLineCount};
+            const uint64_t u64Entries = m_vLineIndex.size();
+            cache.write(uFILEVIEWER_LINE_INDEX_MAGIC, 8);
+            cache.write(reinterpret_cast<const char*>(au64Header), sizeof(au64Header));
+            cache.write(reinterpret_cast<const char*>(&u64Entries), sizeof(u64Entries));
+            cache.write(reinterpret_cast<const char*>(m_vLineIndex.data()), static_cast<std::streamsize>(m_vLineIndex.size() * sizeof(uint64_t)));
+        }
+
+        /**
+         * Options of the hex views: the layout of hexutils::HexDump2 in the viewer colors, then the flags.
+         */
+        bool hexOptions(std::size_t szBytesPerLine, const std::string& flagString, hexutils::HexDumpOptions& options) const
+        {
+            options.szBytesPerLine = szBytesPerLine;
+            options.eStyle = hexutils::HexDumpStyle::SectionColors;
+            options.eColor = m_bColors ? hexutils::HexDumpColor::Always : hexutils::HexDumpColor::Never;
+            options.palette = {uFILEVIEWER_OFFSET_COLOR, uFILEVIEWER_HEX_COLOR, uFILEVIEWER_ASCII_COLOR, uFILEVIEWER_RESET_COLOR};
+
+            std::string strError;
+            if (!hexutils::HexDumpParseFlags(flagString, options, &strError)) {
+                std::printf(uFILEVIEWER_CFMT(m_bColors, uFILEVIEWER_ERROR_COLOR, "Error: Invalid flag string: %s\n"), strError.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * Current size of the file.
+         */
+        std::size_t fileSize() const
+        {
+            return m_Mapping.valid() ? m_Mapping.size() : streamSize();
+        }
+
+        /**
+         * Size of the file now, bytes appended after the mapping included.
+         */
+        std::size_t streamSize() const
+        {
+            if (!m_bValid) {
+                return 0;
+            }
+            m_File.clear(); // Clear any error flags
+            m_File.seekg(0, std::ios::end);
+            const std::streamoff size = m_File.tellg();
+            return (size > 0) ? static_cast<std::size_t>(size) : 0;
         }
 
         mutable std::ifstream m_File;
+        std::string m_strFilename;
+        uFileMapping m_Mapping;
         bool m_bValid = true;
+        bool m_bColors = true;
+        std::size_t m_szPageBytesPerLine = 16;
+        std::size_t m_szPageLines = 32;
+        std::string m_strPageFlags;
+        std::vector<uint64_t> m_vLineIndex;     // offsets of the lines 0, stride, 2 * stride, ...
+        std::size_t m_szLineCount = 0;
+        std::size_t m_szIndexSize = 0;          // size and modification time of the file when the index was built
+        int64_t m_i64IndexTime = 0;
+        std::atomic<bool> m_bStopFollow{false};
+#if !defined(_WIN32)
+        int m_aiWakePipe[2] = {-1, -1};         // wakes the follow loop from stopFollow()
+        std::atomic<int> m_iWakeWrite{-1};
+#endif
 
 };
 
@@ -0,0 +1,502 @@
+#ifndef UHEXDUMPDIFF_HPP
+#define UHEXDUMPDIFF_HPP
+
+#include "uHexdumpUtils.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <bit>
+
+#if( 1 == uHEXDUMP_USE_COLORS )
+    #define uHEXDUMP_DIFF_COLOR                "\033[7m"      // Reverse video
+#else
+    #define uHEXDUMP_DIFF_COLOR                ""
+#endif
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace hexutils
+ * @brief Side by side diff dumps: only the lines where two buffers differ are printed, the differing bytes
+ *        highlighted, the identical regions skipped with a vectorized compare.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace hexutils
+{
+
+/**
+ * @brief Summary of a diff dump.
+ */
+struct HexDiffStats {
+    size_t szCompared = 0;          /**< Bytes walked, the size of the longer input */
+    size_t szDiffBytes = 0;         /**< Differing bytes, the tail of the longer input included */
+    size_t szRegions = 0;           /**< Runs of consecutive differing bytes */
+    size_t szDiffLines = 0;         /**< Lines printed */
+    size_t szFirstDiff = SIZE_MAX;  /**< Offset of the first differing byte, SIZE_MAX when the inputs are identical */
+
+    bool identical() const noexcept { return 0 == szDiffBytes; }
+};
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace internal
+ * @brief Contains internal helper functions for the diff dumps.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace internal
+{
+
+/**
+ * @brief Mismatch kernel: returns the index of the first byte where pA and pB differ, szLen if none does.
+ */
+using HexDiffMismatchFn = size_t (*)(const uint8_t* pA, const uint8_t* pB, size_t szLen);
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Portable mismatch, one 64-bit word per step.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t hexdiff_mismatch_scalar(const uint8_t* pA, const uint8_t* pB, size_t szLen) noexcept
+{
+    size_t i = 0;
+    for (; i + 8 <= szLen; i += 8) {
+        uint64_t u64A, u64B;
+        std::memcpy(&u64A, pA + i, sizeof(u64A));
+        std::memcpy(&u64B, pB + i, sizeof(u64B));
+        const uint64_t u64Diff = u64A ^ u64B;
+        if (0 != u64Diff) {
+            const int iBit = (std::endian::little == std::endian::native) ? std::countr_zero(u64Diff) : std::countl_zero(u64Diff);
+            return i + static_cast<size_t>(iBit) / 8;
+        }
+    }
+    for (; (i < szLen) && (pA[i] == pB[i]); ++i) {
+    }
+    return i;
+
+} /* hexdiff_mismatch_scalar() */
+
+
+#if defined(uHEXDUMP_SIMD_X86)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief SSE2 mismatch, 64 bytes per step.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("sse2")))
+inline size_t hexdiff_mismatch_sse2(const uint8_t* pA, const uint8_t* pB, size_t szLen) noexcept
+{
+    size_t i = 0;
+    for (; i + 64 <= szLen; i += 64) {
+        __m128i equal = _mm_set1_epi8(-1);
+        for (size_t k = 0; k < 64; k += 16) {
+            equal = _mm_and_si128(equal, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pA + i + k)),
+                                                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(pB + i + k))));
+        }
+        if (0xFFFF != _mm_movemask_epi8(equal)) {
+            break;
+        }
+    }
+    for (; i + 16 <= szLen; i += 16) {
+        const unsigned uMask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pA + i)),
+                                                                                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(pB + i)))));
+        if (0xFFFFU != uMask) {
+            return i + static_cast<size_t>(std::countr_zero(~uMask));
+        }
+    }
+    return i + hexdiff_mismatch_scalar(pA + i, pB + i, szLen - i);
+
+} /* hexdiff_mismatch_sse2() */
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief AVX2 mismatch, 128 bytes per step.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+inline size_t hexdiff_mismatch_avx2(const uint8_t* pA, const uint8_t* pB, size_t szLen) noexcept
+{
+    size_t i = 0;
+    for (; i + 128 <= szLen; i += 128) {
+        __m256i equal = _mm256_set1_epi8(-1);
+        for (size_t k = 0; k < 128; k += 32) {
+            equal = _mm256_and_si256(equal, _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pA + i + k)),
+                                                              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pB + i + k))));
+        }
+        if (-1 != _mm256_movemask_epi8(equal)) {
+            break;
+        }
+    }
+    for (; i + 32 <= szLen; i += 32) {
+        const uint32_t u32Mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pA + i)),
+                                                                                              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pB + i)))));
+        if (0xFFFFFFFFU != u32Mask) {
+            return i + static_cast<size_t>(std::countr_zero(~u32Mask));
+        }
+    }
+    return i + hexdiff_mismatch_sse2(pA + i, pB + i, szLen - i);
+
+} /* hexdiff_mismatch_avx2() */
+
+#elif defined(uHEXDUMP_SIMD_NEON)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief NEON mismatch, 64 bytes per step.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t hexdiff_mismatch_neon(const uint8_t* pA, const uint8_t* pB, size_t szLen) noexcept
+{
+    size_t i = 0;
+    for (; i + 64 <= szLen; i += 64) {
+        uint8x16_t equal = vdupq_n_u8(0xFF);
+        for (size_t k = 0; k < 64; k += 16) {
+            equal = vandq_u8(equal, vceqq_u8(vld1q_u8(pA + i + k), vld1q_u8(pB + i + k)));
+        }
+        if (0xFF != vminvq_u8(equal)) {
+            break;
+        }
+    }
+    return i + hexdiff_mismatch_scalar(pA + i, pB + i, szLen - i);
+
+} /* hexdiff_mismatch_neon() */
+
+#endif /* uHEXDUMP_SIMD_X86 / uHEXDUMP_SIMD_NEON */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Selects the best mismatch kernel supported by the running CPU (evaluated once).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline HexDiffMismatchFn hexdiff_mismatch()
+{
+    static const HexDiffMismatchFn pfnMismatch = []() -> HexDiffMismatchFn {
+#if defined(uHEXDUMP_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return hexdiff_mismatch_avx2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return hexdiff_mismatch_sse2;
+        }
+#elif defined(uHEXDUMP_SIMD_NEON)
+        return hexdiff_mismatch_neon;
+#endif
+        return hexdiff_mismatch_scalar;
+    }();
+
+    return pfnMismatch;
+
+} /* hexdiff_mismatch() */
+
+} /* namespace internal */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Incremental side by side diff dump of two inputs, fed chunk by chunk.
+ *
+ * A printed line reads "offset | hex A | ascii A || hex B | ascii B". With colors the differing bytes are
+ * shown in reverse video; without, a line of '^' under them follows every printed line. Bytes present in
+ * one input only (the tail of the longer one) count as differing.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+class HexDiffer
+{
+public:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Prepares a diff.
+     * @param options Layout of the lines (the style and bSqueeze are ignored), colors already resolved.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    explicit HexDiffer(const HexDumpOptions& options = {})
+        : m_Options(options)
+        , m_bColors(HexDumpColor::Always == options.eColor)
+        , m_pfnMismatch(internal::hexdiff_mismatch())
+    {
+        m_strLine.reserve(256);
+        m_strMarker.reserve(256);
+    }
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Compares the next chunks of both inputs and hands the differing lines to fnFlush.
+     *
+     * @param pA Next chunk of the first input.
+     * @param szA Size of the chunk of the first input.
+     * @param pB Next chunk of the second input.
+     * @param szB Size of the chunk of the second input.
+     * @param fnFlush Called as fnFlush(const char* pText, size_t szLen) with blocks of lines.
+     *
+     * @note Every chunk but the last must be a multiple of bytes_per_line() on both sides, so the lines
+     *       keep their positions; an input which ended is passed as an empty chunk.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    void update(const uint8_t* pA, size_t szA, const uint8_t* pB, size_t szB, Flush&& fnFlush)
+    {
+        const size_t szBpl = m_Options.szBytesPerLine;
+        const size_t szCommon = std::min(szA, szB);
+        const size_t szTotal = std::max(szA, szB);
+        if (0 == szBpl) {
+            return;
+        }
+
+        std::string strOut;
+        size_t szPos = 0;
+
+        while (szPos < szTotal) {
+            if (szPos < szCommon) {
+                const size_t szMismatch = szPos + m_pfnMismatch(pA + szPos, pB + szPos, szCommon - szPos);
+                if (szMismatch >= szTotal) {
+                    break;
+                }
+                szPos = szMismatch - szMismatch % szBpl;
+            }
+
+            render_line(pA, szA, pB, szB, szPos);
+            strOut.append(m_strLine);
+            if (strOut.size() >= internal::g_szHexDumpBufferSize) {
+                fnFlush(static_cast<const char*>(strOut.data()), strOut.size());
+                strOut.clear();
+            }
+            szPos += szBpl;
+        }
+
+        if (!strOut.empty()) {
+            fnFlush(static_cast<const char*>(strOut.data()), strOut.size());
+        }
+
+        m_szOffset += szTotal;
+        m_Stats.szCompared += szTotal;
+
+    } /* update() */
+
+
+    /**
+     * @brief Returns the statistics gathered so far.
+     */
+    const HexDiffStats& stats() const noexcept { return m_Stats; }
+
+    /**
+     * @brief Returns the number of bytes per line.
+     */
+    size_t bytes_per_line() const noexcept { return m_Options.szBytesPerLine; }
+
+private:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Appends text to the line, and as many blanks or '^' to the marker line of the uncolored dumps.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    void put(std::string_view strText, bool bMark)
+    {
+        m_strLine.append(strText);
+        if (!m_bColors) {
+            m_strMarker.append(strText.size(), bMark ? '^' : ' ');
+        }
+
+    } /* put() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Appends a colored section opener or closer (nothing in the uncolored dumps).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    void escape(std::string_view strEscape)
+    {
+        if (m_bColors) {
+            m_strLine.append(strEscape);
+        }
+
+    } /* escape() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Appends the hex or ASCII column of one side, differing bytes highlighted.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    void put_column(const uint8_t* pData, size_t szLen, size_t szWidth, const uint8_t* pbDiff, bool bHex, std::string_view strColor)
+    {
+        escape(strColor);
+        for (size_t j = 0; j < szWidth; ++j) {
+            char acCell[3] = {' ', ' ', ' '};
+            const size_t szCell = bHex ? 2 : 1;
+            if (j < szLen) {
+                if (bHex) {
+                    acCell[0] = internal::g_acHexDumpDigits[pData[j] >> 4];
+                    acCell[1] = internal::g_acHexDumpDigits[pData[j] & 0xF];
+                } else {
+                    acCell[0] = internal::hexdump_is_print(pData[j]) ? static_cast<char>(pData[j]) : '.';
+                }
+            }
+            if ((0 != pbDiff[j]) && (j < szLen)) {
+                escape(uHEXDUMP_DIFF_COLOR);
+                put(std::string_view(acCell, szCell), true);
+                escape(m_Options.palette.strReset);
+                escape(strColor);
+            } else {
+                put(std::string_view(acCell, szCell), false);
+            }
+            if (bHex && m_Options.bShowSpaces) {
+                put(" ", false);
+            }
+        }
+        escape(m_Options.palette.strReset);
+
+    } /* put_column() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Formats the line starting at szLineStart of the current chunks into m_strLine and updates the
+     *        statistics.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    void render_line(const uint8_t* pA, size_t szA, const uint8_t* pB, size_t szB, size_t szLineStart)
+    {
+        const size_t szBpl = m_Options.szBytesPerLine;
+        const size_t szLenA = (szLineStart < szA) ? std::min(szBpl, szA - szLineStart) : 0;
+        const size_t szLenB = (szLineStart < szB) ? std::min(szBpl, szB - szLineStart) : 0;
+        const size_t szLen = std::max(szLenA, szLenB);
+
+        m_vbDiff.assign(szBpl, 0);
+        for (size_t j = 0; j < szLen; ++j) {
+            const bool bDiff = (j >= szLenA) || (j >= szLenB) || (pA[szLineStart + j] != pB[szLineStart + j]);
+            if (bDiff) {
+                const size_t szAt = m_szOffset + szLineStart + j;
+                m_vbDiff[j] = 1;
+                ++m_Stats.szDiffBytes;
+                m_Stats.szRegions += (szAt != m_szRegionEnd) ? 1 : 0;
+                m_Stats.szFirstDiff = std::min(m_Stats.szFirstDiff, szAt);
+                m_szRegionEnd = szAt + 1;
+            }
+        }
+        ++m_Stats.szDiffLines;
+
+        m_strLine.clear();
+        m_strMarker.clear();
+        const uint8_t* pbDiff = m_vbDiff.data();
+
+        if (m_Options.bShowOffset) {
+            char acOffset[32];
+            char* pEnd = internal::hexdump_offset(acOffset, m_Options.szBaseOffset + m_szOffset + szLineStart, m_Options.bDecimalOffset);
+            escape(m_Options.palette.strOffset);
+            put(std::string_view(acOffset, static_cast<size_t>(pEnd - acOffset)), false);
+            put(" | ", false);
+            escape(m_Options.palette.strReset);
+        }
+
+        put_column(pA + szLineStart, szLenA, szBpl, pbDiff, true, m_Options.palette.strHex);
+        if (m_Options.bShowAscii) {
+            put(" | ", false);
+            put_column(pA + szLineStart, szLenA, szBpl, pbDiff, false, m_Options.palette.strAscii);
+        }
+        put(" || ", false);
+        put_column(pB + szLineStart, szLenB, szBpl, pbDiff, true, m_Options.palette.strHex);
+        if (m_Options.bShowAscii) {
+            put(" | ", false);
+            put_column(pB + szLineStart, szLenB, szLenB, pbDiff, false, m_Options.palette.strAscii);
+        }
+        m_strLine.push_back('\n');
+
+        if (!m_bColors) {
+            m_strMarker.erase(m_strMarker.find_last_not_of(' ') + 1);
+            m_strLine.append(m_strMarker).push_back('\n');
+        }
+
+    } /* render_line() */
+
+    HexDumpOptions m_Options;                   ///< Layout of the lines.
+    bool m_bColors;                             ///< Highlight with escapes rather than marker lines.
+    internal::HexDiffMismatchFn m_pfnMismatch;  ///< Mismatch kernel of the running CPU.
+    HexDiffStats m_Stats;                       ///< Statistics so far.
+    size_t m_szOffset = 0;                      ///< Offset of the current chunks in the inputs.
+    size_t m_szRegionEnd = SIZE_MAX;            ///< Offset following the last differing byte.
+    std::vector<uint8_t> m_vbDiff;              ///< Differing bytes of the current line.
+    std::string m_strLine;                      ///< The current line.
+    std::string m_strMarker;                    ///< The '^' line of the uncolored dumps.
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Diff dump of two buffers to a sink.
+ *
+ * @param pA Pointer to the first buffer.
+ * @param szA Size of the first buffer in bytes.
+ * @param pB Pointer to the second buffer.
+ * @param szB Size of the second buffer in bytes.
+ * @param sink Callable taking (const char* pText, size_t szLen), see the HexDump*Sink classes.
+ * @param options Layout of the lines; HexDumpColor::Auto gives no colors.
+ * @return The statistics of the diff.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Sink>
+inline HexDiffStats HexDiffTo(const uint8_t* pA, size_t szA, const uint8_t* pB, size_t szB, Sink&& sink, const HexDumpOptions& options = {})
+{
+    HexDiffer differ(internal::hexdump_resolve_color(options, -1));
+    differ.update(pA, szA, pB, szB, sink);
+    return differ.stats();
+
+} /* HexDiffTo() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Diff dump of two buffers to a FILE stream.
+ *
+ * @param pA Pointer to the first buffer.
+ * @param szA Size of the first buffer in bytes.
+ * @param pB Pointer to the second buffer.
+ * @param szB Size of the second buffer in bytes.
+ * @param options Layout of the lines.
+ * @param pFile The output stream (default is stdout).
+ * @return The statistics of the diff.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline HexDiffStats HexDiff(const uint8_t* pA, size_t szA, const uint8_t* pB, size_t szB, const HexDumpOptions& options = {}, std::FILE* pFile = stdout)
+{
+    HexDiffer differ(internal::hexdump_resolve_color(options, internal::hexdump_fileno(pFile)));
+    differ.update(pA, szA, pB, szB, HexDumpFileSink(pFile));
+    return differ.stats();
+
+} /* HexDiff() */
+
+} // namespace hexutils
+
+#endif // UHEXDUMPDIFF_HPP
@@ -0,0 +1,720 @@
+#ifndef UHEXDUMPLAYOUT_HPP
+#define UHEXDUMPLAYOUT_HPP
+
+#include "uHexdumpUtils.hpp"
+#include "uHexlifyUtils.hpp"
+#include "uNumericUtils.hpp"
+#include "uIniParser.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <span>
+#include <algorithm>
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace hexutils
+ * @brief Annotated hexdumps: the dump lines are followed by the names and decoded values of the fields
+ *        described by a HexDumpLayout.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace hexutils
+{
+
+/**
+ * @brief How the bytes of a field are decoded.
+ */
+enum class HexFieldType {
+    Unsigned,   /**< Unsigned integer of 1 to 8 bytes, shown in decimal */
+    Signed,     /**< Two's complement integer of 1 to 8 bytes, shown in decimal */
+    Hex,        /**< Unsigned integer of 1 to 8 bytes, shown as 0x... */
+    Float,      /**< IEEE 754 float (4 bytes) or double (8 bytes) */
+    Bytes,      /**< Raw bytes, shown hexlified */
+    Ascii       /**< Text, non-printable characters shown as '.' */
+};
+
+/**
+ * @brief One field of a layout: szLength bytes at szOffset of the dumped buffer.
+ */
+struct HexField {
+    size_t szOffset = 0;                            /**< Offset of the field in the dumped buffer */
+    size_t szLength = 0;                            /**< Size of the field in bytes */
+    std::string strName;                            /**< Name shown in the annotation */
+    HexFieldType eType = HexFieldType::Unsigned;    /**< How the bytes are decoded */
+    Endianness eEndian = Endianness::Little;        /**< Byte order of the numeric types */
+};
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace internal
+ * @brief Contains internal helper functions for the annotated hexdumps.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace internal
+{
+
+constexpr size_t g_szHexFieldMaxBytes = 16;  /**< Bytes shown for a Bytes field before ".." */
+constexpr size_t g_szHexFieldMaxChars = 32;  /**< Characters shown for an Ascii field before ".." */
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Removes leading and trailing whitespace from a layout token.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline std::string_view hexfield_trim(std::string_view str) noexcept
+{
+    const size_t szFirst = str.find_first_not_of(" \t");
+    if (std::string_view::npos == szFirst) {
+        return {};
+    }
+    return str.substr(szFirst, str.find_last_not_of(" \t") - szFirst + 1);
+
+} /* hexfield_trim() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Reads a field type name: u, i, x, f, bytes or str, and the u8..u64 / i8..i64 / x8..x64 / f32 / f64
+ *        shorthands which also give the length.
+ * @param strType The type name.
+ * @param eType Receives the type.
+ * @param szImpliedLength Receives the length given by the name, 0 if it gives none.
+ * @return False if the name is unknown.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool hexfield_parse_type(std::string_view strType, HexFieldType& eType, size_t& szImpliedLength)
+{
+    bool bRetVal = true;
+    szImpliedLength = 0;
+
+    do {
+        if ("bytes" == strType) {
+            eType = HexFieldType::Bytes;
+            break;
+        }
+        if ("str" == strType) {
+            eType = HexFieldType::Ascii;
+            break;
+        }
+
+        switch (strType.empty() ? '\0' : strType.front()) {
+            case 'u': eType = HexFieldType::Unsigned; break;
+            case 'i': eType = HexFieldType::Signed;   break;
+            case 'x': eType = HexFieldType::Hex;      break;
+            case 'f': eType = HexFieldType::Float;    break;
+            default:  bRetVal = false;                break;
+        }
+        if (!bRetVal || (1 == strType.size())) {
+            break;
+        }
+
+        std::string_view strBits = strType.substr(1);
+        if ((strBits == "8") && (HexFieldType::Float != eType)) {
+            szImpliedLength = 1;
+        } else if ((strBits == "16") && (HexFieldType::Float != eType)) {
+            szImpliedLength = 2;
+        } else if (strBits == "32") {
+            szImpliedLength = 4;
+        } else if (strBits == "64") {
+            szImpliedLength = 8;
+        } else {
+            bRetVal = false;
+        }
+
+    } while (false);
+
+    return bRetVal;
+
+} /* hexfield_parse_type() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Tells whether the length suits the type: 1 to 8 bytes for the integers, 4 or 8 for Float,
+ *        at least 1 otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool hexfield_valid_length(HexFieldType eType, size_t szLength) noexcept
+{
+    switch (eType) {
+        case HexFieldType::Unsigned:
+        case HexFieldType::Signed:
+        case HexFieldType::Hex:   return (szLength >= 1) && (szLength <= 8);
+        case HexFieldType::Float: return (4 == szLength) || (8 == szLength);
+        default:                  return szLength >= 1;
+    }
+
+} /* hexfield_valid_length() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the maximum number of characters the value of a field takes once decoded.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t hexfield_value_size(const HexField& field) noexcept
+{
+    switch (field.eType) {
+        case HexFieldType::Unsigned:
+        case HexFieldType::Signed: return 20;
+        case HexFieldType::Hex:    return 2 + 2 * field.szLength;
+        case HexFieldType::Float:  return 32;
+        case HexFieldType::Bytes:  return 2 * std::min(field.szLength, g_szHexFieldMaxBytes) + 2;
+        default:                   return std::min(field.szLength, g_szHexFieldMaxChars) + 2;
+    }
+
+} /* hexfield_value_size() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Assembles the bytes of a 1 to 8 byte field into an integer, in the byte order of the field.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline uint64_t hexfield_load(const uint8_t* pField, size_t szLength, Endianness eEndian) noexcept
+{
+    uint64_t u64Value = 0;
+    for (size_t i = 0; i < szLength; ++i) {
+        const size_t szIndex = (Endianness::Big == eEndian) ? i : (szLength - 1 - i);
+        u64Value = (u64Value << 8) | pField[szIndex];
+    }
+    return u64Value;
+
+} /* hexfield_load() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Writes the decoded value of a field, "??" when the field runs past the end of the data.
+ * @param field The field.
+ * @param pData The dumped buffer.
+ * @param szDataSize Size of the dumped buffer.
+ * @param pOut Output position, with hexfield_value_size(field) characters of room.
+ * @return The position after the value.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline char* hexfield_format(const HexField& field, const uint8_t* pData, size_t szDataSize, char* pOut) noexcept
+{
+    if ((field.szOffset > szDataSize) || (field.szLength > szDataSize - field.szOffset)) {
+        *pOut++ = '?';
+        *pOut++ = '?';
+        return pOut;
+    }
+
+    const uint8_t* pField = pData + field.szOffset;
+    char* const pEnd = pOut + hexfield_value_size(field);
+
+    switch (field.eType) {
+        case HexFieldType::Unsigned: {
+            pOut = std::to_chars(pOut, pEnd, hexfield_load(pField, field.szLength, field.eEndian)).ptr;
+            break;
+        }
+        case HexFieldType::Signed: {
+            const unsigned uShift = static_cast<unsigned>(64 - 8 * field.szLength);
+            const int64_t i64Value = static_cast<int64_t>(hexfield_load(pField, field.szLength, field.eEndian) << uShift) >> uShift;
+            pOut = std::to_chars(pOut, pEnd, i64Value).ptr;
+            break;
+        }
+        case HexFieldType::Hex: {
+            // most significant byte first, whatever the byte order of the field
+            uint8_t au8Value[8];
+            const uint64_t u64Value = hexfield_load(pField, field.szLength, field.eEndian);
+            for (size_t i = 0; i < field.szLength; ++i) {
+                au8Value[i] = static_cast<uint8_t>(u64Value >> (8 * (field.szLength - 1 - i)));
+            }
+            *pOut++ = '0';
+            *pOut++ = 'x';
+            pOut += string_hexlify(std::as_bytes(std::span<const uint8_t>(au8Value, field.szLength)), std::span<char>(pOut, pEnd));
+            break;
+        }
+        case HexFieldType::Float: {
+            const uint64_t u64Bits = hexfield_load(pField, field.szLength, field.eEndian);
+            if (4 == field.szLength) {
+                const uint32_t u32Bits = static_cast<uint32_t>(u64Bits);
+                float fValue;
+                std::memcpy(&fValue, &u32Bits, sizeof(fValue));
+                pOut = std::to_chars(pOut, pEnd, fValue).ptr;
+            } else {
+                double dValue;
+                std::memcpy(&dValue, &u64Bits, sizeof(dValue));
+                pOut = std::to_chars(pOut, pEnd, dValue).ptr;
+            }
+            break;
+        }
+        case HexFieldType::Bytes: {
+            const size_t szShown = std::min(field.szLength, g_szHexFieldMaxBytes);
+            pOut += string_hexlify(std::as_bytes(std::span<const uint8_t>(pField, szShown)), std::span<char>(pOut, pEnd));
+            if (szShown < field.szLength) {
+                *pOut++ = '.';
+                *pOut++ = '.';
+            }
+            break;
+        }
+        default: {
+            const size_t szShown = std::min(field.szLength, g_szHexFieldMaxChars);
+            for (size_t i = 0; i < szShown; ++i) {
+                *pOut++ = hexdump_is_print(pField[i]) ? static_cast<char>(pField[i]) : '.';
+            }
+            if (szShown < field.szLength) {
+                *pOut++ = '.';
+                *pOut++ = '.';
+            }
+            break;
+        }
+    }
+
+    return pOut;
+
+} /* hexfield_format() */
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the number of columns taken by a rendered text: its bytes outside the color escapes
+ *        ("\033[" parameters and a final letter).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t hexfield_visible_width(const char* pText, const char* pEnd) noexcept
+{
+    size_t szWidth = 0;
+
+    while (pText < pEnd) {
+        if ('\033' != *pText) {
+            ++szWidth;
+            ++pText;
+            continue;
+        }
+        pText += ((pEnd - pText >= 2) && ('[' == pText[1])) ? 2 : 1;
+        for (; (pText < pEnd) && ((*pText < '@') || (*pText > '~')); ++pText) {
+        }
+        pText += (pText < pEnd) ? 1 : 0;
+    }
+
+    return szWidth;
+
+} /* hexfield_visible_width() */
+
+} /* namespace internal */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Description of the fields of a binary structure, e.g. a protocol frame, kept sorted by offset.
+ *
+ * Fields may be added one by one or read from an INI section where every key is a field name and every
+ * value reads "offset, length, type[, le|be]" or "offset, type[, le|be]" when the type gives the length:
+ *
+ * @code
+ * [frame]
+ * sync    = 0, x16, be
+ * length  = 2, u16, be
+ * payload = 4, 8, bytes
+ * crc     = 0x0C, u32
+ * @endcode
+ *
+ * The types are u, i, x (1 to 8 bytes), f (4 or 8 bytes), bytes and str; u8..u64, i8..i64, x8..x64,
+ * f32 and f64 give the length. Offsets and lengths accept the 0x, 0b and 0 prefixes of uNumericUtils.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+class HexDumpLayout
+{
+public:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Adds a field.
+     * @return False if its length does not suit its type.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    bool add(const HexField& field)
+    {
+        bool bRetVal = false;
+
+        if (internal::hexfield_valid_length(field.eType, field.szLength)) {
+            auto it = std::upper_bound(m_vFields.begin(), m_vFields.end(), field.szOffset,
+                                       [](size_t szOffset, const HexField& other) { return szOffset < other.szOffset; });
+            m_vFields.insert(it, field);
+            bRetVal = true;
+        }
+
+        return bRetVal;
+
+    } /* add() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Adds a field described by a "offset, length, type[, le|be]" specification.
+     * @param strName The field name.
+     * @param strSpec The specification, see the class description.
+     * @return False if the specification is invalid.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    bool add(const std::string& strName, const std::string& strSpec)
+    {
+        bool bRetVal = false;
+
+        do {
+            std::vector<std::string_view> vTokens;
+            std::string_view strRest = strSpec;
+            for (size_t szComma = 0; szComma != std::string_view::npos; ) {
+                szComma = strRest.find(',');
+                vTokens.push_back(internal::hexfield_trim(strRest.substr(0, szComma)));
+                strRest.remove_prefix((std::string_view::npos == szComma) ? strRest.size() : szComma + 1);
+            }
+
+            HexField field;
+            field.strName = strName;
+            uint64_t u64Offset = 0;
+            uint64_t u64Length = 0;
+
+            if (internal::hexfield_trim(strName).empty() || (vTokens.size() < 2) ||
+                !numeric::str2uint64(std::string(vTokens[0]), u64Offset)) {
+                break;
+            }
+            field.szOffset = static_cast<size_t>(u64Offset);
+
+            // the length is optional when the type name gives it
+            size_t szTypeToken = 1;
+            size_t szImpliedLength = 0;
+            if (!internal::hexfield_parse_type(vTokens[1], field.eType, szImpliedLength)) {
+                if ((vTokens.size() < 3) || !numeric::str2uint64(std::string(vTokens[1]), u64Length) ||
+                    !internal::hexfield_parse_type(vTokens[2], field.eType, szImpliedLength)) {
+                    break;
+                }
+                field.szLength = static_cast<size_t>(u64Length);
+                szTypeToken = 2;
+                if ((0 != szImpliedLength) && (szImpliedLength != field.szLength)) {
+                    break;
+                }
+            }
+            if (0 != szImpliedLength) {
+                field.szLength = szImpliedLength;
+            }
+
+            if (vTokens.size() > szTypeToken + 2) {
+                break;
+            }
+            if (vTokens.size() == szTypeToken + 2) {
+                if ("be" == vTokens.back()) {
+                    field.eEndian = Endianness::Big;
+                } else if ("le" != vTokens.back()) {
+                    break;
+                }
+            }
+
+            bRetVal = add(field);
+
+        } while (false);
+
+        return bRetVal;
+
+    } /* add() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Adds the fields of an INI section, one key per field.
+     * @param ini The loaded INI file.
+     * @param strSection Name of the section describing the layout.
+     * @return False if the section is missing or one of its fields is invalid (the valid ones are kept).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    bool load(const IniParser& ini, const std::string& strSection)
+    {
+        std::map<std::string, std::string> mapFields;
+        bool bRetVal = ini.getSection(strSection, mapFields);
+
+        for (const auto& [strName, strSpec] : mapFields) {
+            bRetVal = add(strName, strSpec) && bRetVal;
+        }
+
+        return bRetVal;
+
+    } /* load() */
+
+
+    /**
+     * @brief Returns the fields, sorted by offset.
+     */
+    const std::vector<HexField>& fields() const noexcept { return m_vFields; }
+
+private:
+    std::vector<HexField> m_vFields;  ///< The fields, sorted by offset (insertion order among equal offsets).
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Renders annotated dumps: every line is followed by "name=value" for the fields starting in it.
+ *
+ * The fields are sorted by offset and walked with a cursor along the lines, so lines without fields cost one
+ * comparison over a raw dump and annotated lines one decode per field, whatever the offsets of the fields.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+class HexDumpAnnotator
+{
+public:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Compiles the layout for the given dump layout.
+     * @param layout The fields to annotate.
+     * @param options Layout of the dump, colors already resolved (Auto is not colored).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    explicit HexDumpAnnotator(const HexDumpLayout& layout, const HexDumpOptions& options = {})
+        : m_Renderer(options)
+        , m_vFields(layout.fields())
+        , m_szBaseOffset(options.szBaseOffset)
+        , m_bSqueeze(options.bSqueeze)
+    {
+        const size_t szBpl = m_Renderer.bytes_per_line();
+        if ((0 == szBpl) || m_vFields.empty()) {
+            return;
+        }
+
+        m_vFieldSizes.reserve(m_vFields.size());
+        for (const HexField& field : m_vFields) {
+            m_vFieldSizes.push_back(2 + field.strName.size() + 1 + internal::hexfield_value_size(field));
+        }
+
+        // the annotations start after the widest line, in columns (the color escapes take none)
+        std::vector<uint8_t> vZeros(szBpl, 0);
+        std::vector<char> vLine(m_Renderer.max_line_size());
+        const char* const pLineEnd = m_Renderer.render_line(vZeros.data(), szBpl, 0, vLine.data()) - 1;
+        m_szLineWidth = internal::hexfield_visible_width(vLine.data(), pLineEnd);
+    }
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Formats an annotated dump, handing the text to fnFlush block by block.
+     * @param pData Pointer to the data buffer to be dumped, the field offsets are relative to it.
+     * @param szDataSize Size of the data buffer in bytes.
+     * @param fnFlush Called as fnFlush(const char* pText, size_t szLen) for every filled block of lines.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    void render(const uint8_t* pData, size_t szDataSize, Flush&& fnFlush) const
+    {
+        const size_t szBpl = m_Renderer.bytes_per_line();
+        if ((0 == szBpl) || (0 == szDataSize)) {
+            return;
+        }
+
+        const size_t szLineRoom = m_Renderer.max_line_size() + m_szLineWidth;
+        std::vector<char> vBuffer(std::max(internal::g_szHexDumpBufferSize, 2 * szLineRoom));
+        size_t szUsed = 0;
+        bool bInRun = false;
+
+        // the fields of a line are [szFirst, szLast), the fields of the previous lines are behind the cursor
+        size_t szLast = 0;
+
+        for (size_t i = 0; i < szDataSize; i += szBpl) {
+            const size_t szFirst = szLast;
+            while ((szLast < m_vFields.size()) && (m_vFields[szLast].szOffset - i < szBpl)) {
+                ++szLast;
+            }
+
+            size_t szRoom = szLineRoom;
+            for (size_t f = szFirst; f < szLast; ++f) {
+                szRoom += m_vFieldSizes[f];
+            }
+            if (szUsed + szRoom > vBuffer.size()) {
+                if (0 != szUsed) {
+                    fnFlush(static_cast<const char*>(vBuffer.data()), szUsed);
+                    szUsed = 0;
+                }
+                if (szRoom > vBuffer.size()) {
+                    vBuffer.resize(szRoom);
+                }
+            }
+
+            char* const pLine = vBuffer.data() + szUsed;
+            char* pOut = pLine;
+
+            if ((szFirst == szLast) && m_bSqueeze && internal::hexdump_is_repeat(pData, szDataSize, i, szBpl)) {
+                if (!bInRun) {
+                    bInRun = true;
+                    *pOut++ = '*';
+                    *pOut++ = '\n';
+                }
+            } else {
+                bInRun = false;
+                pOut = m_Renderer.render_line(pData + i, std::min(szBpl, szDataSize - i), m_szBaseOffset + i, pOut);
+                if (szFirst != szLast) {
+                    // replace the newline by the padding and the annotations
+                    --pOut;
+                    for (size_t szWidth = internal::hexfield_visible_width(pLine, pOut); szWidth < m_szLineWidth; ++szWidth) {
+                        *pOut++ = ' ';
+                    }
+                    for (size_t f = szFirst; f < szLast; ++f) {
+                        *pOut++ = ' ';
+                        *pOut++ = ' ';
+                        pOut = internal::hexdump_append(pOut, m_vFields[f].strName);
+                        *pOut++ = '=';
+                        pOut = internal::hexfield_format(m_vFields[f], pData, szDataSize, pOut);
+                    }
+                    *pOut++ = '\n';
+                }
+            }
+
+            szUsed += static_cast<size_t>(pOut - pLine);
+        }
+
+        if (0 != szUsed) {
+            fnFlush(static_cast<const char*>(vBuffer.data()), szUsed);
+        }
+
+    } /* render() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Dumps a buffer to a FILE stream, one fwrite() per block.
+     * @param pData Pointer to the data buffer to be dumped.
+     * @param szDataSize Size of the data buffer in bytes.
+     * @param pFile The output stream (default is stdout).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    void dump(const uint8_t* pData, size_t szDataSize, std::FILE* pFile = stdout) const
+    {
+        render(pData, szDataSize, [pFile](const char* pText, size_t szLen) {
+            std::fwrite(pText, 1, szLen, pFile);
+        });
+
+    } /* dump() */
+
+private:
+    HexDumpRenderer m_Renderer;             ///< Formats the dump lines.
+    std::vector<HexField> m_vFields;        ///< The fields, sorted by offset.
+    std::vector<size_t> m_vFieldSizes;      ///< Room taken by the annotation of each field.
+    size_t m_szLineWidth = 0;               ///< Column where the annotations start (escapes not counted).
+    size_t m_szBaseOffset = 0;              ///< Added to the offsets shown in the dump.
+    bool m_bSqueeze = false;                ///< Squeeze the repeated lines without fields.
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Outputs a hexadecimal dump annotated with the fields of a layout.
+ *
+ * @param pData Pointer to the data buffer to be dumped, the field offsets are relative to it.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param layout The fields to annotate.
+ * @param options Layout of the dump (szBaseOffset only changes the displayed offsets).
+ * @param pFile The output stream (default is stdout).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void HexDumpAnnotated(const uint8_t* pData, size_t szDataSize, const HexDumpLayout& layout, const HexDumpOptions& options = {},
+                             std::FILE* pFile = stdout)
+{
+    HexDumpAnnotator(layout, internal::hexdump_resolve_color(options, internal::hexdump_fileno(pFile))).dump(pData, szDataSize, pFile);
+
+} /* HexDumpAnnotated() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns a hexadecimal dump annotated with the fields of a layout as a string.
+ *
+ * @param pData Pointer to the data buffer to be dumped, the field offsets are relative to it.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param layout The fields to annotate.
+ * @param options Layout of the dump; HexDumpColor::Auto gives no colors.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline std::string HexDumpAnnotatedString(const uint8_t* pData, size_t szDataSize, const HexDumpLayout& layout, const HexDumpOptions& options = {})
+{
+    std::string str;
+    HexDumpAnnotator(layout, internal::hexdump_resolve_color(options, -1)).render(pData, szDataSize, HexDumpStringSink<std::string>(str));
+    return str;
+
+} /* HexDumpAnnotatedString() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Outputs an annotated dump laid out like HexDump2S(), with the layout read from an INI section.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param szBytesPerLine Number of bytes to display per line.
+ * @param flagString A string containing formatting flags, see HexDump1S().
+ * @param ini The loaded INI file.
+ * @param strSection Name of the section describing the layout, see HexDumpLayout.
+ * @return False if the flag string or the layout is invalid; nothing is dumped then.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool HexDumpAnnotatedS(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine, const std::string& flagString,
+                              const IniParser& ini, const std::string& strSection)
+{
+    bool bRetVal = false;
+
+    do {
+        HexDumpOptions options;
+        options.szBytesPerLine = szBytesPerLine;
+        options.eStyle = HexDumpStyle::SectionColors;
+        options.eColor = internal::g_eHexDumpColor.load();
+
+        if (!HexDumpParseFlags(flagString, options)) {
+            break;
+        }
+
+        HexDumpLayout layout;
+        if (!layout.load(ini, strSection)) {
+            std::printf("Invalid layout section: %s\n", strSection.c_str());
+            break;
+        }
+
+        HexDumpAnnotated(pData, szDataSize, layout, options);
+        bRetVal = true;
+
+    } while (false);
+
+    return bRetVal;
+
+} /* HexDumpAnnotatedS() */
+
+} // namespace hexutils
+
+#endif // UHEXDUMPLAYOUT_HPP
@@ -0,0 +1,505 @@
+#ifndef UHEXDUMPREVERSE_HPP
+#define UHEXDUMPREVERSE_HPP
+
+#include "uHexdumpUtils.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace hexutils
+ * @brief Reverse hexdumps (as xxd -r): the bytes are rebuilt from the text written by HexDump1/2/3, the
+ *        buffered dumps and uFileViewer::showhex.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace hexutils
+{
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace internal
+ * @brief Contains internal helper functions for the reverse hexdumps.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+namespace internal
+{
+
+/**
+ * @brief Marks the characters of the pair tables which are not hexadecimal digits.
+ */
+constexpr uint16_t g_u16HexPairInvalid = 0x100;
+
+/**
+ * @brief Default limit of the zeros written for a forward jump of the offsets (a hole).
+ */
+constexpr size_t g_szHexReverseMaxHole = 64 * 1024 * 1024;
+
+/**
+ * @brief Value of a hex digit in the high (bHigh) or the low nibble of a byte, g_u16HexPairInvalid for
+ *        the other characters; a pair decodes as high[c0] | low[c1], invalid if bit 8 is set.
+ */
+template<bool bHigh>
+constexpr std::array<uint16_t, 256> g_au16HexPairTable = []() {
+    std::array<uint16_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = g_u16HexPairInvalid;
+    }
+    for (uint16_t i = 0; i < 16; ++i) {
+        const uint16_t u16Value = bHigh ? static_cast<uint16_t>(i << 4) : i;
+        table[static_cast<uint8_t>("0123456789ABCDEF"[i])] = u16Value;
+        table[static_cast<uint8_t>("0123456789abcdef"[i])] = u16Value;
+    }
+    return table;
+}();
+
+} /* namespace internal */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Incremental reverse hexdump, fed with text chunks split anywhere.
+ *
+ * Every line is "[offset | ]hex bytes[ | ascii]", the hex bytes with or without a space after each one;
+ * the ASCII column is ignored and color escapes are skipped. A "*" line stands for repetitions of the line
+ * before it, up to the offset of the next line; a forward jump of the offsets without "*" is filled with
+ * zeros (as xxd -r leaves a hole), up to a limit: a larger jump, as from a corrupt line or a dump taken at a
+ * large offset without the matching szBaseOffset, is an error. Offsets which do not fit in size_t are errors.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+class HexDumpReverser
+{
+public:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Prepares a reverse dump.
+     * @param options Format of the dump: bShowOffset and bDecimalOffset describe the offset column and
+     *        szBaseOffset is the offset of the first rebuilt byte; the other settings are detected.
+     * @param szMaxHole Largest forward jump of the offsets filled with zeros.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    explicit HexDumpReverser(const HexDumpOptions& options = {}, size_t szMaxHole = internal::g_szHexReverseMaxHole)
+        : m_bOffset(options.bShowOffset)
+        , m_bDecimal(options.bDecimalOffset)
+        , m_szNext(options.szBaseOffset)
+        , m_szMaxHole(szMaxHole)
+    {
+        m_vOut.reserve(internal::g_szHexDumpBufferSize);
+    }
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Parses the next chunk of text and hands the rebuilt bytes to fnFlush.
+     * @param pText The text chunk; a line may continue in the next chunk.
+     * @param szLen Size of the chunk.
+     * @param fnFlush Called as fnFlush(const uint8_t* pData, size_t szLen) with blocks of bytes.
+     * @return False on a malformed line, see error(); the following calls do nothing.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    bool update(const char* pText, size_t szLen, Flush&& fnFlush)
+    {
+        const char* pEnd = pText + szLen;
+
+        while (m_bOk && (pText < pEnd)) {
+            const char* pNewline = static_cast<const char*>(std::memchr(pText, '\n', static_cast<size_t>(pEnd - pText)));
+            if (nullptr == pNewline) {
+                m_strPending.append(pText, pEnd);
+                break;
+            }
+            if (m_strPending.empty()) {
+                parse_line(std::string_view(pText, static_cast<size_t>(pNewline - pText)), fnFlush);
+            } else {
+                m_strPending.append(pText, pNewline);
+                parse_line(m_strPending, fnFlush);
+                m_strPending.clear();
+            }
+            pText = pNewline + 1;
+        }
+
+        flush(fnFlush);
+        return m_bOk;
+
+    } /* update() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Parses the last line if it has no newline and checks that the dump is complete.
+     * @param fnFlush As for update().
+     * @return False on a malformed dump, see error().
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    bool finish(Flush&& fnFlush)
+    {
+        if (m_bOk && !m_strPending.empty()) {
+            parse_line(m_strPending, fnFlush);
+            m_strPending.clear();
+        }
+        if (m_bOk && m_bSqueezed) {
+            fail("the dump ends inside a squeezed run");
+        }
+
+        flush(fnFlush);
+        return m_bOk;
+
+    } /* finish() */
+
+
+    /**
+     * @brief Returns the message of the first error, empty if none.
+     */
+    const std::string& error() const noexcept { return m_strError; }
+
+    /**
+     * @brief Returns the number of bytes rebuilt so far.
+     */
+    size_t size() const noexcept { return m_szSize; }
+
+private:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Records an error with the number of the current line.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    void fail(const char* pstrMessage)
+    {
+        m_bOk = false;
+        m_strError = "line " + std::to_string(m_szLine) + ": " + pstrMessage;
+
+    } /* fail() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Hands the pending bytes to fnFlush.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    void flush(Flush& fnFlush)
+    {
+        if (!m_vOut.empty()) {
+            fnFlush(static_cast<const uint8_t*>(m_vOut.data()), m_vOut.size());
+            m_vOut.clear();
+        }
+
+    } /* flush() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Appends bytes to the output, flushing full blocks.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    void emit(const uint8_t* pData, size_t szLen, Flush& fnFlush)
+    {
+        m_vOut.insert(m_vOut.end(), pData, pData + szLen);
+        m_szSize += szLen;
+        if (m_vOut.size() >= internal::g_szHexDumpBufferSize) {
+            flush(fnFlush);
+        }
+
+    } /* emit() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Fills the output up to szOffset, with repetitions of the last line after a "*" line and with
+     *        zeros otherwise.
+     * @return False if the gap is not a whole number of repeated lines, or a hole larger than the limit.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    bool fill_to(size_t szOffset, Flush& fnFlush)
+    {
+        size_t szGap = szOffset - m_szNext;
+
+        if (m_bSqueezed) {
+            const size_t szLast = m_vLast.size();
+            if ((0 == szLast) || (0 != szGap % szLast)) {
+                fail("the squeezed run is not a whole number of lines");
+                return false;
+            }
+            for (; szGap > 0; szGap -= szLast) {
+                emit(m_vLast.data(), szLast, fnFlush);
+            }
+        } else {
+            if (szGap > m_szMaxHole) {
+                fail("the offset jumps past the hole limit (a corrupt offset, or szBaseOffset not set?)");
+                return false;
+            }
+            static const std::array<uint8_t, 4096> au8Zeros{};
+            while (szGap > 0) {
+                const size_t szStep = std::min(szGap, au8Zeros.size());
+                emit(au8Zeros.data(), szStep, fnFlush);
+                szGap -= szStep;
+            }
+        }
+
+        m_szNext = szOffset;
+        return true;
+
+    } /* fill_to() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Copies the line without its color escapes ("\033[" parameters and a final letter) into m_strPlain.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    std::string_view strip_escapes(std::string_view strLine)
+    {
+        m_strPlain.resize(strLine.size());
+        char* pOut = m_strPlain.data();
+        const char* p = strLine.data();
+        const char* const pEnd = p + strLine.size();
+
+        while (p < pEnd) {
+            if ('\033' != *p) {
+                *pOut++ = *p++;
+                continue;
+            }
+            p += ((pEnd - p >= 2) && ('[' == p[1])) ? 2 : 1;
+            for (; (p < pEnd) && ((*p < '@') || (*p > '~')); ++p) {
+            }
+            p += (p < pEnd) ? 1 : 0;
+        }
+        return std::string_view(m_strPlain.data(), static_cast<size_t>(pOut - m_strPlain.data()));
+
+    } /* strip_escapes() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Parses one line (without its newline) and emits its bytes.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    void parse_line(std::string_view strLine, Flush& fnFlush)
+    {
+        ++m_szLine;
+
+        if (std::string_view::npos != strLine.find('\033')) {
+            strLine = strip_escapes(strLine);
+        }
+        while (!strLine.empty() && (('\r' == strLine.back()) || (' ' == strLine.back()))) {
+            strLine.remove_suffix(1);
+        }
+        if (strLine.empty()) {
+            return;
+        }
+
+        if ("*" == strLine) {
+            if (!m_bOffset) {
+                fail("a squeezed run needs the offset column");
+                return;
+            }
+            if (m_vLast.empty()) {
+                fail("a squeezed run must follow a line");
+                return;
+            }
+            m_bSqueezed = true;
+            return;
+        }
+
+        const char* p = strLine.data();
+        const char* const pEnd = p + strLine.size();
+
+        if (m_bOffset) {
+            size_t szOffset = 0;
+            const char* pDigits = p;
+            if (m_bDecimal) {
+                for (; (p < pEnd) && (*p >= '0') && (*p <= '9'); ++p) {
+                    const size_t szDigit = static_cast<size_t>(*p - '0');
+                    if (szOffset > (SIZE_MAX - szDigit) / 10) {
+                        fail("the offset does not fit in size_t");
+                        return;
+                    }
+                    szOffset = szOffset * 10 + szDigit;
+                }
+            } else {
+                for (; p < pEnd; ++p) {
+                    const uint16_t u16Nibble = internal::g_au16HexPairTable<false>[static_cast<uint8_t>(*p)];
+                    if (internal::g_u16HexPairInvalid == u16Nibble) {
+                        break;
+                    }
+                    if (szOffset > (SIZE_MAX >> 4)) {
+                        fail("the offset does not fit in size_t");
+                        return;
+                    }
+                    szOffset = (szOffset << 4) | u16Nibble;
+                }
+            }
+            if ((p == pDigits) || (pEnd - p < 3) || (0 != std::memcmp(p, " | ", 3))) {
+                fail("expected an offset followed by \" | \"");
+                return;
+            }
+            p += 3;
+
+            if (szOffset < m_szNext) {
+                fail("the offset goes backwards");
+                return;
+            }
+            if ((szOffset > m_szNext) && !fill_to(szOffset, fnFlush)) {
+                return;
+            }
+        } else if (m_bSqueezed) {
+            fail("a squeezed run needs the offset column");
+            return;
+        }
+        m_bSqueezed = false;
+
+        // hex bytes, a single space allowed after each; two spaces or " |" end the column
+        uint8_t au8Line[256];
+        size_t szBytes = 0;
+        m_vLast.clear();
+        while (pEnd - p >= 2) {
+            const uint16_t u16Byte = internal::g_au16HexPairTable<true>[static_cast<uint8_t>(p[0])] | internal::g_au16HexPairTable<false>[static_cast<uint8_t>(p[1])];
+            if (0 != (u16Byte & internal::g_u16HexPairInvalid)) {
+                break;
+            }
+            au8Line[szBytes++] = static_cast<uint8_t>(u16Byte);
+            p += 2;
+            if ((pEnd - p >= 2) && (' ' == p[0]) && (internal::g_u16HexPairInvalid != internal::g_au16HexPairTable<false>[static_cast<uint8_t>(p[1])])) {
+                ++p;
+            }
+            if (sizeof(au8Line) == szBytes) {
+                m_vLast.insert(m_vLast.end(), au8Line, au8Line + szBytes);
+                szBytes = 0;
+            }
+        }
+        m_vLast.insert(m_vLast.end(), au8Line, au8Line + szBytes);
+
+        if ((p < pEnd) && (' ' != *p)) {
+            fail("expected hex bytes");
+            return;
+        }
+        if (m_vLast.empty()) {
+            fail("a line without hex bytes");
+            return;
+        }
+        if (m_vLast.size() > SIZE_MAX - m_szNext) {
+            fail("the offset does not fit in size_t");
+            return;
+        }
+
+        emit(m_vLast.data(), m_vLast.size(), fnFlush);
+        m_szNext += m_vLast.size();
+
+    } /* parse_line() */
+
+    bool m_bOffset;                 ///< The lines start with an offset column.
+    bool m_bDecimal;                ///< The offsets are decimal.
+    bool m_bOk = true;              ///< No error so far.
+    bool m_bSqueezed = false;       ///< A "*" line was read, the next line closes the run.
+    size_t m_szNext;                ///< Offset of the next byte.
+    size_t m_szMaxHole;             ///< Largest forward jump filled with zeros.
+    size_t m_szSize = 0;            ///< Bytes rebuilt so far.
+    size_t m_szLine = 0;            ///< Number of the current line.
+    std::string m_strPending;       ///< Start of a line continued in the next chunk.
+    std::string m_strPlain;         ///< The current line without its color escapes.
+    std::string m_strError;         ///< Message of the first error.
+    std::vector<uint8_t> m_vLast;   ///< Bytes of the last line, repeated by a squeezed run.
+    std::vector<uint8_t> m_vOut;    ///< Bytes not yet flushed.
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Rebuilds the bytes of a dump held in memory.
+ *
+ * @param strDump The text of the dump.
+ * @param vOut Receives the bytes (appended).
+ * @param options Format of the dump, see HexDumpReverser.
+ * @param pstrError Receives the message of a malformed dump.
+ * @param szMaxHole Largest forward jump of the offsets filled with zeros.
+ * @return False if the dump is malformed; vOut holds the bytes of the lines before the error.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool HexDumpReverse(std::string_view strDump, std::vector<uint8_t>& vOut, const HexDumpOptions& options = {}, std::string* pstrError = nullptr,
+                           size_t szMaxHole = internal::g_szHexReverseMaxHole)
+{
+    HexDumpReverser reverser(options, szMaxHole);
+    auto fnAppend = [&vOut](const uint8_t* pData, size_t szLen) { vOut.insert(vOut.end(), pData, pData + szLen); };
+    bool bRetVal = reverser.update(strDump.data(), strDump.size(), fnAppend) && reverser.finish(fnAppend);
+
+    if (!bRetVal && (nullptr != pstrError)) {
+        *pstrError = reverser.error();
+    }
+    return bRetVal;
+
+} /* HexDumpReverse() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Rebuilds the bytes of a dump read from a FILE stream, in blocks, into another stream.
+ *
+ * @param pIn The stream holding the dump.
+ * @param pOut The stream receiving the bytes.
+ * @param options Format of the dump, see HexDumpReverser.
+ * @param pstrError Receives the message of a malformed dump or of a write error.
+ * @param szMaxHole Largest forward jump of the offsets filled with zeros.
+ * @return False if the dump is malformed or the bytes could not be written.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool HexDumpReverseFile(std::FILE* pIn, std::FILE* pOut, const HexDumpOptions& options = {}, std::string* pstrError = nullptr,
+                               size_t szMaxHole = internal::g_szHexReverseMaxHole)
+{
+    HexDumpReverser reverser(options, szMaxHole);
+    std::vector<char> vBuffer(internal::g_szHexDumpBufferSize * 4);
+    bool bWriteOk = true;
+    auto fnWrite = [pOut, &bWriteOk](const uint8_t* pData, size_t szLen) {
+        bWriteOk = bWriteOk && (szLen == std::fwrite(pData, 1, szLen, pOut));
+    };
+
+    bool bRetVal = true;
+    size_t szRead;
+    while (bRetVal && bWriteOk && (0 != (szRead = std::fread(vBuffer.data(), 1, vBuffer.size(), pIn)))) {
+        bRetVal = reverser.update(vBuffer.data(), szRead, fnWrite);
+    }
+    bRetVal = bRetVal && reverser.finish(fnWrite);
+
+    if (nullptr != pstrError) {
+        if (!bRetVal) {
+            *pstrError = reverser.error();
+        } else if (!bWriteOk) {
+            *pstrError = "write error";
+        }
+    }
+    return bRetVal && bWriteOk;
+
+} /* HexDumpReverseFile() */
+
+} // namespace hexutils
+
+#endif // UHEXDUMPREVERSE_HPP
@@ -9,9 +9,42 @@
 #include <cctype>
 #include <cstddef>
 #include <string>
-#include <sstream>
-#include <iomanip>
 #include <stdexcept>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <ostream>
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
+#include <cerrno>
+
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+#ifndef uHEXDUMP_USE_SIMD
+    #define uHEXDUMP_USE_SIMD   1U
+#endif
+
+#if (1 == uHEXDUMP_USE_SIMD)
+    #if defined(__x86_64__) || defined(__i386__)
+        #define uHEXDUMP_SIMD_X86     1
+        #include <immintrin.h>
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #define uHEXDUMP_SIMD_NEON    1
+        #include <arm_neon.h>
+    #endif
+#endif /* (1 == uHEXDUMP_USE_SIMD) */
 
 
 /*--------------------------------------------------------------------------------------------------------*/
@@ -24,7 +57,9 @@
 namespace hexutils
 {
 
-#define uHEXDUMP_USE_COLORS   1U
+#ifndef uHEXDUMP_USE_COLORS
+    #define uHEXDUMP_USE_COLORS   1U
+#endif
 
 #if( 1 == uHEXDUMP_USE_COLORS )
     #define uHEXDUMP_OFFSET_COLOR              "\033[91m"     // Bright Red
@@ -41,36 +76,229 @@ namespace hexutils
 /**
  * @brief Concatenates two arguments and appends a reset color code for formatted output.
  */
-#define FRMT(a, b) a b uHEXDUMP_RESET_COLOR
+#define uHEXDUMP_FRMT(a, b) a b uHEXDUMP_RESET_COLOR
+
+/**
+ * @brief Former name of uHEXDUMP_FRMT.
+ * @deprecated Use uHEXDUMP_FRMT.
+ */
+#ifndef FRMT
+    #define FRMT(a, b) uHEXDUMP_FRMT(a, b)
+#endif
+
+
+
+/**
+ * @brief Color mode of the dumps; uHEXDUMP_USE_COLORS set to 0 removes the escapes at compile time.
+ */
+enum class HexDumpColor {
+    Auto,    /**< Colors only when the destination is a terminal */
+    Always,  /**< Always emit the color escapes */
+    Never    /**< Never emit the color escapes */
+};
+
+/**
+ * @brief Output layouts of the buffered renderer, each one byte-identical to a HexDump variant.
+ */
+enum class HexDumpStyle {
+    PerByteColors,  /**< HexDump1: every byte wrapped in its own color escape */
+    SectionColors,  /**< HexDump2: one color escape per section, at most 96 bytes per line */
+    Plain           /**< HexDump3: no color escapes */
+};
+
+/**
+ * @brief Color escapes of the dump sections, e.g. uFileViewer uses its own. The strings must outlive the
+ *        renderer; in the PerByteColors style a byte escape and the reset take at most 13 characters together.
+ */
+struct HexDumpPalette {
+    std::string_view strOffset = uHEXDUMP_OFFSET_COLOR;  /**< Offset section */
+    std::string_view strHex = uHEXDUMP_HEX_COLOR;        /**< Hex section */
+    std::string_view strAscii = uHEXDUMP_ASCII_COLOR;    /**< ASCII section */
+    std::string_view strReset = uHEXDUMP_RESET_COLOR;    /**< Closes every colored span */
+};
+
+/**
+ * @brief Options of the buffered renderer, the flags of the HexDump functions plus the style.
+ */
+struct HexDumpOptions {
+    size_t szBytesPerLine = 16;                       /**< Number of bytes per line */
+    bool bShowSpaces = true;                          /**< Space after every hex byte */
+    bool bShowAscii = true;                           /**< ASCII column */
+    bool bShowOffset = true;                          /**< Offset column */
+    bool bDecimalOffset = false;                      /**< Decimal instead of hexadecimal offsets */
+    bool bSqueeze = false;                            /**< Runs of identical lines collapse into one "*" line */
+    HexDumpStyle eStyle = HexDumpStyle::PerByteColors; /**< Layout and placement of the color escapes */
+    HexDumpColor eColor = HexDumpColor::Auto;         /**< Whether the color escapes are emitted */
+    size_t szBaseOffset = 0;                          /**< Added to the displayed offsets */
+    HexDumpPalette palette;                           /**< Color escapes of the sections */
+};
 
 
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Outputs a formatted hexadecimal dump of a block of memory.
- *
- * This function prints the contents of a memory block in a human-readable
- * hexadecimal format. It can optionally include ASCII representation,
- * byte offsets, and spacing between bytes.
- *
- * @param pData Pointer to the data buffer to be dumped.
- * @param szDataSize Size of the data buffer in bytes.
- * @param szBytesPerLine Number of bytes to display per line (default is 16).
- * @param bShowSpaces If true, inserts spaces between bytes for readability (default is true).
- * @param bShowAscii If true, appends ASCII representation of bytes to each line (default is true).
- * @param bShowOffset If true, displays the offset at the beginning of each line (default is true).
- * @param bDecimalOffset If true, displays the offset in decimal instead of hexadecimal (default is false).
- *
- * @note This variant immediately prints characters using std::printf, making it suitable for C language usage
- * and embedded systems with limited RAM, as it avoids internal buffering
+ * @namespace internal
+ * @brief Contains internal helper functions shared by the HexDump functions.
  */
 /*--------------------------------------------------------------------------------------------------------*/
+namespace internal
+{
 
-inline void HexDump1 ( const uint8_t *pData, size_t szDataSize, size_t szBytesPerLine = 16, bool bShowSpaces = true, bool bShowAscii = true, bool bShowOffset = true, bool bDecimalOffset = false )
+/**
+ * @brief Color mode of HexDump1 and HexDump2, see HexDumpSetColor().
+ */
+inline std::atomic<HexDumpColor> g_eHexDumpColor{HexDumpColor::Auto};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the file descriptor of a FILE stream.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline int hexdump_fileno(std::FILE* pFile) noexcept
+{
+#if defined(_WIN32)
+    return _fileno(pFile);
+#else
+    return fileno(pFile);
+#endif
+
+} /* hexdump_fileno() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Resolves a color mode against a destination.
+ * @param eColor The requested mode.
+ * @param iFd File descriptor of the destination, negative when it is not a file (string, callback...).
+ * @return True if the color escapes are to be emitted.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool hexdump_use_colors(HexDumpColor eColor, int iFd) noexcept
 {
+    bool bRetVal = false;
+
+    do {
+        if (HexDumpColor::Auto != eColor) {
+            bRetVal = (HexDumpColor::Always == eColor);
+            break;
+        }
+        if (iFd < 0) {
+            break;
+        }
+#if defined(_WIN32)
+        bRetVal = (0 != _isatty(iFd));
+#else
+        bRetVal = (1 == isatty(iFd));
+#endif
+    } while(false);
+
+    return bRetVal;
+
+} /* hexdump_use_colors() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Tells whether a line is squeezed: a full line, identical to the previous one, and not the last
+ *        line of the dump (the last line is always printed, so the end of the data stays visible).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool hexdump_is_repeat(const uint8_t* pData, size_t szDataSize, size_t szLineStart, size_t szBytesPerLine) noexcept
+{
+    return (szLineStart >= szBytesPerLine) && (szLineStart + szBytesPerLine < szDataSize) &&
+           (0 == std::memcmp(pData + szLineStart, pData + szLineStart - szBytesPerLine, szBytesPerLine));
+
+} /* hexdump_is_repeat() */
+
+} // namespace internal
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Sets the color mode of HexDump1 and HexDump2 (default Auto: colors only when stdout is a terminal).
+ *        The other dumps take theirs from HexDumpOptions::eColor.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void HexDumpSetColor(HexDumpColor eColor) noexcept
+{
+    internal::g_eHexDumpColor.store(eColor);
+
+} /* HexDumpSetColor() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Reads a "sSaAoOdDqQ" flag string into the options: uppercase turns a setting on, lowercase off
+ *        (S spaces, A ASCII column, O offset column, D decimal offset, Q squeeze).
+ * @param flagString The flag string, empty keeps the options unchanged.
+ * @param options Receives the settings.
+ * @param pstrError Receives the message of an invalid flag string; when null the message is printed,
+ *        as the HexDump*S functions do.
+ * @return False if the flag string is invalid.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool HexDumpParseFlags(const std::string& flagString, HexDumpOptions& options, std::string* pstrError = nullptr)
+{
+    bool bRetVal = true;
+
+    if (!flagString.empty()) {
+        try {
+            FlagParser flags(flagString);
+
+            if (flagString.find_first_of("sS") != std::string::npos)
+                options.bShowSpaces = flags.get_flag('S');
+            if (flagString.find_first_of("aA") != std::string::npos)
+                options.bShowAscii = flags.get_flag('A');
+            if (flagString.find_first_of("oO") != std::string::npos)
+                options.bShowOffset = flags.get_flag('O');
+            if (flagString.find_first_of("dD") != std::string::npos)
+                options.bDecimalOffset = flags.get_flag('D');
+            if (flagString.find_first_of("qQ") != std::string::npos)
+                options.bSqueeze = flags.get_flag('Q');
+        } catch (const std::exception& e) {
+            if (nullptr != pstrError) {
+                *pstrError = e.what();
+            } else {
+                std::printf("Invalid flag string: %s\n", e.what());
+            }
+            bRetVal = false;
+        }
+    }
+
+    return bRetVal;
+
+} /* HexDumpParseFlags() */
+
+
+
+namespace internal
+{
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief HexDump1, with runs of identical lines replaced by a single "*" line when bSqueeze is set
+ *        (like hexdump -C), as HexDump1S does for the 'Q' flag.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void hexdump1_print(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine, bool bShowSpaces, bool bShowAscii, bool bShowOffset, bool bDecimalOffset, bool bSqueeze)
+{
+    const bool bColors = internal::hexdump_use_colors(internal::g_eHexDumpColor.load(), internal::hexdump_fileno(stdout));
     size_t szOffset = 0;
     size_t szLines = szDataSize / szBytesPerLine;
     size_t szLastLineLen = szDataSize % szBytesPerLine;
+    bool bInRun = false;
 
     if (szLastLineLen != 0) ++szLines;
 
@@ -78,19 +306,33 @@ inline void HexDump1 ( const uint8_t *pData, size_t szDataSize, size_t szBytesPe
         size_t szLineStart = i * szBytesPerLine;
         size_t szLineLen = (i == szLines - 1 && szLastLineLen != 0) ? szLastLineLen : szBytesPerLine;
 
+        /* Squeezed run */
+        if (bSqueeze && internal::hexdump_is_repeat(pData, szDataSize, szLineStart, szBytesPerLine)) {
+            if (!bInRun) {
+                std::printf("*\n");
+            }
+            bInRun = true;
+            continue;
+        }
+        bInRun = false;
+
         /* Offset */
         if (bShowOffset) {
             if (bDecimalOffset) {
-                std::printf(FRMT(uHEXDUMP_OFFSET_COLOR, "%08zu | "), szOffset + szLineStart);
+                std::printf(bColors ? uHEXDUMP_FRMT(uHEXDUMP_OFFSET_COLOR, "%08zu | ") : "%08zu | ", szOffset + szLineStart);
             } else {
-                std::printf(FRMT(uHEXDUMP_OFFSET_COLOR, "%08zX | "), szOffset + szLineStart);
+                std::printf(bColors ? uHEXDUMP_FRMT(uHEXDUMP_OFFSET_COLOR, "%08zX | ") : "%08zX | ", szOffset + szLineStart);
             }
         }
 
         /* Hex values */
         for (size_t j = 0; j < szBytesPerLine; ++j) {
             if (j < szLineLen) {
-                std::printf(bShowSpaces ? FRMT(uHEXDUMP_HEX_COLOR, "%02X ") : FRMT(uHEXDUMP_HEX_COLOR, "%02X"), pData[szLineStart + j]);
+                if (bColors) {
+                    std::printf(bShowSpaces ? uHEXDUMP_FRMT(uHEXDUMP_HEX_COLOR, "%02X ") : uHEXDUMP_FRMT(uHEXDUMP_HEX_COLOR, "%02X"), pData[szLineStart + j]);
+                } else {
+                    std::printf(bShowSpaces ? "%02X " : "%02X", pData[szLineStart + j]);
+                }
             } else {
                 std::printf(bShowSpaces ? "   " : "  ");
             }
@@ -101,13 +343,44 @@ inline void HexDump1 ( const uint8_t *pData, size_t szDataSize, size_t szBytesPe
             std::printf(" | ");
             for (size_t j = 0; j < szLineLen; ++j) {
                 uint8_t ch = pData[szLineStart + j];
-                std::printf(FRMT(uHEXDUMP_ASCII_COLOR, "%c"), std::isprint(ch) ? ch : '.');
+                std::printf(bColors ? uHEXDUMP_FRMT(uHEXDUMP_ASCII_COLOR, "%c") : "%c", std::isprint(ch) ? ch : '.');
             }
         }
 
         std::printf("\n");
     }
 
+} /* hexdump1_print() */
+
+} // namespace internal
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Outputs a formatted hexadecimal dump of a block of memory.
+ *
+ * This function prints the contents of a memory block in a human-readable
+ * hexadecimal format. It can optionally include ASCII representation,
+ * byte offsets, and spacing between bytes.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param szBytesPerLine Number of bytes to display per line (default is 16).
+ * @param bShowSpaces If true, inserts spaces between bytes for readability (default is true).
+ * @param bShowAscii If true, appends ASCII representation of bytes to each line (default is true).
+ * @param bShowOffset If true, displays the offset at the beginning of each line (default is true).
+ * @param bDecimalOffset If true, displays the offset in decimal instead of hexadecimal (default is false).
+ *
+ * @note This variant immediately prints characters using std::printf, making it suitable for C language usage
+ * and embedded systems with limited RAM, as it avoids internal buffering
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void HexDump1 ( const uint8_t *pData, size_t szDataSize, size_t szBytesPerLine = 16, bool bShowSpaces = true, bool bShowAscii = true, bool bShowOffset = true, bool bDecimalOffset = false )
+{
+    internal::hexdump1_print(pData, szDataSize, szBytesPerLine, bShowSpaces, bShowAscii, bShowOffset, bDecimalOffset, false);
+
 } /* HexDump1() */
 
 
@@ -128,74 +401,56 @@ inline void HexDump1 ( const uint8_t *pData, size_t szDataSize, size_t szBytesPe
 
 inline void HexDump1S(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine = 16, const std::string& flagString = "")
 {
-    bool bShowSpaces = true;
-    bool bShowAscii = true;
-    bool bShowOffset = true;
-    bool bDecimalOffset = false;
-
-    if(!flagString.empty()) {
-        try {
-            FlagParser flags(flagString);
+    HexDumpOptions options;
 
-            if (flagString.find_first_of("sS") != std::string::npos)
-                bShowSpaces = flags.get_flag('S');
-            if (flagString.find_first_of("aA") != std::string::npos)
-                bShowAscii = flags.get_flag('A');
-            if (flagString.find_first_of("oO") != std::string::npos)
-                bShowOffset = flags.get_flag('O');
-            if (flagString.find_first_of("dD") != std::string::npos)
-                bDecimalOffset = flags.get_flag('D');
-        } catch (const std::exception& e) {
-            std::printf("Invalid flag string: %s\n", e.what());
-            return;
-        }
+    if (HexDumpParseFlags(flagString, options)) {
+        internal::hexdump1_print(pData, szDataSize, szBytesPerLine, options.bShowSpaces, options.bShowAscii, options.bShowOffset, options.bDecimalOffset, options.bSqueeze);
     }
 
-    HexDump1(pData, szDataSize, szBytesPerLine, bShowSpaces, bShowAscii, bShowOffset, bDecimalOffset);
+} /* HexDump1S() */
 
-} /* HexDump1() */
 
 
+namespace internal
+{
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Outputs a formatted hexadecimal dump of a block of memory.
- *
- * This function prints the contents of a memory block in a human-readable
- * hexadecimal format. It can optionally include ASCII representation,
- * byte offsets, and spacing between bytes.
- *
- * @param pData Pointer to the data buffer to be dumped.
- * @param szDataSize Size of the data buffer in bytes.
- * @param szBytesPerLine Number of bytes to display per line (default is 16).
- * @param bShowSpaces If true, inserts spaces between bytes for readability (default is true).
- * @param bShowAscii If true, appends ASCII representation of bytes to each line (default is true).
- * @param bShowOffset If true, displays the offset at the beginning of each line (default is true).
- * @param bDecimalOffset If true, displays the offset in decimal instead of hexadecimal (default is false).
- *
- * @note This variant accumulates data into a buffer and prints it in three sections,
- * making it compatible with C language usage as it avoids C++-specific features.
+ * @brief HexDump2, with runs of identical lines replaced by a single "*" line when bSqueeze is set
+ *        (like hexdump -C), as HexDump2S does for the 'Q' flag.
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-inline void HexDump2(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine, bool bShowSpaces, bool bShowAscii, bool bShowOffset, bool bDecimalOffset)
+inline void hexdump2_print(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine, bool bShowSpaces, bool bShowAscii, bool bShowOffset, bool bDecimalOffset, bool bSqueeze)
 {
     if (szBytesPerLine > 96) {
         szBytesPerLine = 96;
     }
 
+    const bool bColors = internal::hexdump_use_colors(internal::g_eHexDumpColor.load(), internal::hexdump_fileno(stdout));
     size_t szOffset = 0;
     size_t szLines = szDataSize / szBytesPerLine;
     size_t szLastLineLen = szDataSize % szBytesPerLine;
+    bool bInRun = false;
 
     if (szLastLineLen != 0) ++szLines;
 
-    char buffer[288];  // Shared buffer for all sections max 96
+    char buffer[96 * 3 + 1];  // Shared buffer for all sections max 96, plus the terminator
 
     for (size_t i = 0; i < szLines; ++i) {
         size_t szLineStart = i * szBytesPerLine;
         size_t szLineLen = (i == szLines - 1 && szLastLineLen != 0) ? szLastLineLen : szBytesPerLine;
 
+        /* Squeezed run */
+        if (bSqueeze && internal::hexdump_is_repeat(pData, szDataSize, szLineStart, szBytesPerLine)) {
+            if (!bInRun) {
+                std::printf("*\n");
+            }
+            bInRun = true;
+            continue;
+        }
+        bInRun = false;
+
         /*  Offset */
         if (bShowOffset) {
             if (bDecimalOffset) {
@@ -203,7 +458,7 @@ inline void HexDump2(const uint8_t* pData, size_t szDataSize, size_t szBytesPerL
             } else {
                 snprintf(buffer, sizeof(buffer), "%08zX | ", szOffset + szLineStart);
             }
-            std::printf(FRMT(uHEXDUMP_OFFSET_COLOR, "%s"), buffer);
+            std::printf(bColors ? uHEXDUMP_FRMT(uHEXDUMP_OFFSET_COLOR, "%s") : "%s", buffer);
         }
 
         /* Hex values */
@@ -217,7 +472,7 @@ inline void HexDump2(const uint8_t* pData, size_t szDataSize, size_t szBytesPerL
                                 bShowSpaces ? "   " : "  ");
             }
         }
-        std::printf(FRMT(uHEXDUMP_HEX_COLOR, "%s"), buffer);
+        std::printf(bColors ? uHEXDUMP_FRMT(uHEXDUMP_HEX_COLOR, "%s") : "%s", buffer);
 
         /* ASCII characters */
         if (bShowAscii) {
@@ -227,56 +482,42 @@ inline void HexDump2(const uint8_t* pData, size_t szDataSize, size_t szBytesPerL
                 uint8_t ch = pData[szLineStart + j];
                 pos += snprintf(buffer + pos, sizeof(buffer) - pos, "%c", isprint(ch) ? ch : '.');
             }
-            std::printf(FRMT(uHEXDUMP_ASCII_COLOR, "%s"), buffer);
+            std::printf(bColors ? uHEXDUMP_FRMT(uHEXDUMP_ASCII_COLOR, "%s") : "%s", buffer);
         }
 
         std::printf("\n");
     }
 
-} /* HexDump2() */
+} /* hexdump2_print() */
+
+} // namespace internal
 
 
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Outputs a formatted hexadecimal dump of a memory block using a flag string for customization.
+ * @brief Outputs a formatted hexadecimal dump of a block of memory.
  *
- * This variant of HexDump1 allows customization of the output format through a flag string.
- * Each character in the flag string can represent a specific formatting option (e.g., show ASCII, show offset, etc.).
+ * This function prints the contents of a memory block in a human-readable
+ * hexadecimal format. It can optionally include ASCII representation,
+ * byte offsets, and spacing between bytes.
  *
  * @param pData Pointer to the data buffer to be dumped.
  * @param szDataSize Size of the data buffer in bytes.
- * @param szBytesPerLine Number of bytes to display per line.
- * @param flagString A string containing formatting flags to control the output style.
+ * @param szBytesPerLine Number of bytes to display per line (default is 16).
+ * @param bShowSpaces If true, inserts spaces between bytes for readability (default is true).
+ * @param bShowAscii If true, appends ASCII representation of bytes to each line (default is true).
+ * @param bShowOffset If true, displays the offset at the beginning of each line (default is true).
+ * @param bDecimalOffset If true, displays the offset in decimal instead of hexadecimal (default is false).
+ *
+ * @note This variant accumulates data into a buffer and prints it in three sections,
+ * making it compatible with C language usage as it avoids C++-specific features.
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-inline void HexDump2S(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine = 16, const std::string& flagString = "")
+inline void HexDump2(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine, bool bShowSpaces, bool bShowAscii, bool bShowOffset, bool bDecimalOffset)
 {
-    bool bShowSpaces = true;
-    bool bShowAscii = true;
-    bool bShowOffset = true;
-    bool bDecimalOffset = false;
-
-    if(!flagString.empty()) {
-        try {
-            FlagParser flags(flagString);
-
-            if (flagString.find_first_of("sS") != std::string::npos)
-                bShowSpaces = flags.get_flag('S');
-            if (flagString.find_first_of("aA") != std::string::npos)
-                bShowAscii = flags.get_flag('A');
-            if (flagString.find_first_of("oO") != std::string::npos)
-                bShowOffset = flags.get_flag('O');
-            if (flagString.find_first_of("dD") != std::string::npos)
-                bDecimalOffset = flags.get_flag('D');
-        } catch (const std::exception& e) {
-            std::printf("Invalid flag string: %s\n", e.what());
-            return;
-        }
-    }
-
-    HexDump2(pData, szDataSize, szBytesPerLine, bShowSpaces, bShowAscii, bShowOffset, bDecimalOffset);
+    internal::hexdump2_print(pData, szDataSize, szBytesPerLine, bShowSpaces, bShowAscii, bShowOffset, bDecimalOffset, false);
 
 } /* HexDump2() */
 
@@ -284,72 +525,1390 @@ inline void HexDump2S(const uint8_t* pData, size_t szDataSize, size_t szBytesPer
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Outputs a formatted hexadecimal dump of a block of memory.
+ * @brief Outputs a formatted hexadecimal dump of a memory block using a flag string for customization.
  *
- * This function prints the contents of a memory block in a human-readable
- * hexadecimal format. It can optionally include ASCII representation,
- * byte offsets, and spacing between bytes.
+ * This variant of HexDump1 allows customization of the output format through a flag string.
+ * Each character in the flag string can represent a specific formatting option (e.g., show ASCII, show offset, etc.).
  *
  * @param pData Pointer to the data buffer to be dumped.
  * @param szDataSize Size of the data buffer in bytes.
- * @param szBytesPerLine Number of bytes to display per line (default is 16).
- * @param bShowSpaces If true, inserts spaces between bytes for readability (default is true).
- * @param bShowAscii If true, appends ASCII representation of bytes to each line (default is true).
- * @param bShowOffset If true, displays the offset at the beginning of each line (default is true).
- * @param bDecimalOffset If true, displays the offset in decimal instead of hexadecimal (default is false).
- *
- * @note This C++ variant gathers all data before printing it in a single operation.
+ * @param szBytesPerLine Number of bytes to display per line.
+ * @param flagString A string containing formatting flags to control the output style.
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-inline void HexDump3 ( const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine = 16, bool bShowSpaces = true, bool bShowAscii = true, bool bShowOffset = true, bool bDecimalOffset = false )
+inline void HexDump2S(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine = 16, const std::string& flagString = "")
 {
-    size_t szOffset = 0;
-    size_t szLines = szDataSize / szBytesPerLine;
-    size_t szLastLineLen = szDataSize % szBytesPerLine;
+    HexDumpOptions options;
 
-    if (szLastLineLen != 0) ++szLines;
+    if (HexDumpParseFlags(flagString, options)) {
+        internal::hexdump2_print(pData, szDataSize, szBytesPerLine, options.bShowSpaces, options.bShowAscii, options.bShowOffset, options.bDecimalOffset, options.bSqueeze);
+    }
 
-    for (size_t i = 0; i < szLines; ++i) {
-        std::ostringstream ossline;
-        size_t szLineStart = i * szBytesPerLine;
-        size_t szLineLen = (i == szLines - 1 && szLastLineLen != 0) ? szLastLineLen : szBytesPerLine;
+} /* HexDump2S() */
 
-        /* Offset */
 
-        if (bShowOffset) {
-            if (bDecimalOffset) {
-                ossline << std::dec << std::setw(8) << std::setfill('0') << (szOffset + szLineStart) << " | ";
-            } else {
-                ossline << std::hex << std::uppercase << std::setw(8) << std::setfill('0') << (szOffset + szLineStart) << " | ";
-            }
-        }
 
-        /* Hex values */
-        for (size_t j = 0; j < szBytesPerLine; ++j) {
-            if (j < szLineLen) {
-                ossline << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << static_cast<int>(pData[szLineStart + j]);
-                if (bShowSpaces) {
-                    ossline << ' ';
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @namespace internal
+ * @brief Contains internal helper functions for the hexdump renderer.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+namespace internal
+{
+
+/**
+ * @brief Size of the output buffer of the renderer, flushed with one write per block.
+ */
+constexpr size_t g_szHexDumpBufferSize = 64 * 1024;
+
+/**
+ * @brief Size of a prebuilt cell (the text of one byte), copied with one fixed-size store.
+ */
+constexpr size_t g_szHexDumpCellSize = 16;
+
+/**
+ * @brief Default input bytes formatted per task by HexDumpParallel (rounded down to whole lines).
+ */
+constexpr size_t g_szHexDumpParallelBlockSize = 64 * 1024;
+
+/**
+ * @brief Default size below which HexDumpParallel formats on the calling thread.
+ */
+constexpr size_t g_szHexDumpParallelThreshold = 4 * 1024 * 1024;
+
+/**
+ * @brief Maximum number of bytes per line of HexDump2.
+ */
+constexpr size_t g_szHexDumpMaxBytesPerLine2 = 96;
+
+constexpr char g_acHexDumpDigits[] = "0123456789ABCDEF";
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Tells whether a byte is printed as is in the ASCII column (std::isprint in the "C" locale).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+constexpr bool hexdump_is_print(uint8_t ch) noexcept
+{
+    return (ch >= 0x20) && (ch < 0x7F);
+
+} /* hexdump_is_print() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Copies a string to pOut and returns the position after it.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline char* hexdump_append(char* pOut, std::string_view str) noexcept
+{
+    if (!str.empty()) {
+        std::memcpy(pOut, str.data(), str.size());
+    }
+    return pOut + str.size();
+
+} /* hexdump_append() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Writes an offset as "%08zX" or "%08zu" would, without the printf family.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline char* hexdump_offset(char* pOut, size_t szOffset, bool bDecimal) noexcept
+{
+    char acDigits[24];
+    size_t szDigits = 0;
+
+    if (bDecimal) {
+        do {
+            acDigits[szDigits++] = static_cast<char>('0' + szOffset % 10);
+            szOffset /= 10;
+        } while (0 != szOffset);
+    } else {
+        do {
+            acDigits[szDigits++] = g_acHexDumpDigits[szOffset & 0xF];
+            szOffset >>= 4;
+        } while (0 != szOffset);
+    }
+
+    while (szDigits < 8) {
+        acDigits[szDigits++] = '0';
+    }
+    while (szDigits > 0) {
+        *pOut++ = acDigits[--szDigits];
+    }
+
+    return pOut;
+
+} /* hexdump_offset() */
+
+
+
+/**
+ * @brief Column kernel: formats the leading whole blocks of szLen bytes and returns how many bytes it consumed.
+ *        The caller formats the remaining bytes with the cell tables.
+ */
+using HexDumpColumnFn = size_t (*)(const uint8_t* pIn, size_t szLen, char* pOut);
+
+/**
+ * @brief The column kernels selected for the running CPU.
+ */
+struct HexDumpKernels {
+    HexDumpColumnFn pfnHex;        /**< "XX" per byte */
+    HexDumpColumnFn pfnHexSpaced;  /**< "XX " per byte */
+    HexDumpColumnFn pfnAscii;      /**< Printable bytes as is, '.' otherwise */
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Fallback column kernel: consumes nothing, the cell tables format the whole column.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t hexdump_column_scalar(const uint8_t*, size_t, char*) noexcept
+{
+    return 0;
+
+} /* hexdump_column_scalar() */
+
+
+
+#if defined(uHEXDUMP_SIMD_X86)
+
+/**
+ * @brief pshufb controls spreading 32 hex characters (held in two registers) into 48 "XX " characters:
+ *        for output register k, row 2k selects from the first register, row 2k+1 from the second, 0x80 zeroes.
+ */
+constexpr std::array<std::array<uint8_t, 16>, 6> g_aau8HexDumpSpreadShuffles = []() {
+    std::array<std::array<uint8_t, 16>, 6> masks{};
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t i = 0; i < 16; ++i) {
+            const size_t szPos = 16 * k + i;
+            const size_t szChar = 2 * (szPos / 3) + (szPos % 3);
+            const bool bSpace = (2 == szPos % 3);
+            masks[2 * k][i]     = (!bSpace && (szChar < 16))  ? static_cast<uint8_t>(szChar)      : 0x80;
+            masks[2 * k + 1][i] = (!bSpace && (szChar >= 16)) ? static_cast<uint8_t>(szChar - 16) : 0x80;
+        }
+    }
+    return masks;
+}();
+
+/**
+ * @brief The blanks of the 48 "XX " characters, OR-ed over the spread hex characters.
+ */
+constexpr std::array<std::array<uint8_t, 16>, 3> g_aau8HexDumpSpreadBlanks = []() {
+    std::array<std::array<uint8_t, 16>, 3> blanks{};
+    for (size_t szPos = 0; szPos < 48; ++szPos) {
+        blanks[szPos / 16][szPos % 16] = (2 == szPos % 3) ? ' ' : 0;
+    }
+    return blanks;
+}();
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts 16 bytes to their 32 uppercase hex characters, bytes 0-7 in lo and 8-15 in hi.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("ssse3")))
+inline void hexdump_hex16_ssse3(const uint8_t* pIn, __m128i& lo, __m128i& hi) noexcept
+{
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+    const __m128i mask   = _mm_set1_epi8(0x0F);
+    const __m128i bytes  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn));
+    const __m128i high   = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+    const __m128i low    = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, mask));
+
+    lo = _mm_unpacklo_epi8(high, low);
+    hi = _mm_unpackhi_epi8(high, low);
+
+} /* hexdump_hex16_ssse3() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Spreads 32 hex characters into 48 "XX " characters.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("ssse3")))
+inline void hexdump_spread16_ssse3(__m128i lo, __m128i hi, char* pOut) noexcept
+{
+    for (size_t k = 0; k < 3; ++k) {
+        const __m128i fromLo = _mm_shuffle_epi8(lo, _mm_loadu_si128(reinterpret_cast<const __m128i*>(g_aau8HexDumpSpreadShuffles[2 * k].data())));
+        const __m128i fromHi = _mm_shuffle_epi8(hi, _mm_loadu_si128(reinterpret_cast<const __m128i*>(g_aau8HexDumpSpreadShuffles[2 * k + 1].data())));
+        const __m128i blanks = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g_aau8HexDumpSpreadBlanks[k].data()));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + 16 * k), _mm_or_si128(_mm_or_si128(fromLo, fromHi), blanks));
+    }
+
+} /* hexdump_spread16_ssse3() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Maps 16 bytes to the ASCII column: printable bytes as is, '.' otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("ssse3")))
+inline __m128i hexdump_ascii16_ssse3(__m128i bytes) noexcept
+{
+    /* signed compares: 0x80..0xFF are negative, hence not above 0x1F */
+    const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(0x1F)), _mm_cmplt_epi8(bytes, _mm_set1_epi8(0x7F)));
+    return _mm_or_si128(_mm_and_si128(printable, bytes), _mm_andnot_si128(printable, _mm_set1_epi8('.')));
+
+} /* hexdump_ascii16_ssse3() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief SSSE3 column kernels, 16 bytes per step.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("ssse3")))
+inline size_t hexdump_hex_ssse3(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= szLen; i += 16) {
+        __m128i lo, hi;
+        hexdump_hex16_ssse3(pIn + i, lo, hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + 2 * i),      lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + 2 * i + 16), hi);
+    }
+    return i;
+
+} /* hexdump_hex_ssse3() */
+
+
+__attribute__((target("ssse3")))
+inline size_t hexdump_hex_spaced_ssse3(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= szLen; i += 16) {
+        __m128i lo, hi;
+        hexdump_hex16_ssse3(pIn + i, lo, hi);
+        hexdump_spread16_ssse3(lo, hi, pOut + 3 * i);
+    }
+    return i;
+
+} /* hexdump_hex_spaced_ssse3() */
+
+
+__attribute__((target("ssse3")))
+inline size_t hexdump_ascii_ssse3(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= szLen; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), hexdump_ascii16_ssse3(bytes));
+    }
+    return i;
+
+} /* hexdump_ascii_ssse3() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts 32 bytes to their 64 uppercase hex characters, bytes 0-15 in first and 16-31 in second.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+inline void hexdump_hex32_avx2(const uint8_t* pIn, __m256i& first, __m256i& second) noexcept
+{
+    const __m256i digits = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F',
+                                            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+    const __m256i mask   = _mm256_set1_epi8(0x0F);
+    const __m256i bytes  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn));
+    const __m256i high   = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+    const __m256i low    = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, mask));
+
+    /* the unpacks work per 128-bit lane: lo holds bytes 0-7 and 16-23, hi holds 8-15 and 24-31 */
+    const __m256i lo = _mm256_unpacklo_epi8(high, low);
+    const __m256i hi = _mm256_unpackhi_epi8(high, low);
+    first  = _mm256_permute2x128_si256(lo, hi, 0x20);
+    second = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+} /* hexdump_hex32_avx2() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief AVX2 column kernels, 32 bytes per step and a 16-byte step for the rest.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+inline size_t hexdump_hex_avx2(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    size_t i = 0;
+    for (; i + 32 <= szLen; i += 32) {
+        __m256i first, second;
+        hexdump_hex32_avx2(pIn + i, first, second);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + 2 * i),      first);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + 2 * i + 32), second);
+    }
+    return i + hexdump_hex_ssse3(pIn + i, szLen - i, pOut + 2 * i);
+
+} /* hexdump_hex_avx2() */
+
+
+__attribute__((target("avx2")))
+inline size_t hexdump_hex_spaced_avx2(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    size_t i = 0;
+    for (; i + 32 <= szLen; i += 32) {
+        __m256i first, second;
+        hexdump_hex32_avx2(pIn + i, first, second);
+        hexdump_spread16_ssse3(_mm256_castsi256_si128(first),  _mm256_extracti128_si256(first, 1),  pOut + 3 * i);
+        hexdump_spread16_ssse3(_mm256_castsi256_si128(second), _mm256_extracti128_si256(second, 1), pOut + 3 * i + 48);
+    }
+    return i + hexdump_hex_spaced_ssse3(pIn + i, szLen - i, pOut + 3 * i);
+
+} /* hexdump_hex_spaced_avx2() */
+
+
+__attribute__((target("avx2")))
+inline size_t hexdump_ascii_avx2(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    size_t i = 0;
+    for (; i + 32 <= szLen; i += 32) {
+        const __m256i bytes     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + i));
+        const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(0x1F)),
+                                                   _mm256_cmpgt_epi8(_mm256_set1_epi8(0x7F), bytes));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i), _mm256_blendv_epi8(_mm256_set1_epi8('.'), bytes, printable));
+    }
+    return i + hexdump_ascii_ssse3(pIn + i, szLen - i, pOut + i);
+
+} /* hexdump_ascii_avx2() */
+
+#elif defined(uHEXDUMP_SIMD_NEON)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief NEON column kernels, 16 bytes per step; the interleaving stores lay out "XX" and "XX " directly.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t hexdump_hex_neon(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    static constexpr uint8_t au8Digits[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+    const uint8x16_t digits = vld1q_u8(au8Digits);
+
+    size_t i = 0;
+    for (; i + 16 <= szLen; i += 16) {
+        const uint8x16_t bytes = vld1q_u8(pIn + i);
+        uint8x16x2_t chars;
+        chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+        chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+        vst2q_u8(reinterpret_cast<uint8_t*>(pOut + 2 * i), chars);
+    }
+    return i;
+
+} /* hexdump_hex_neon() */
+
+
+inline size_t hexdump_hex_spaced_neon(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    static constexpr uint8_t au8Digits[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+    const uint8x16_t digits = vld1q_u8(au8Digits);
+
+    size_t i = 0;
+    for (; i + 16 <= szLen; i += 16) {
+        const uint8x16_t bytes = vld1q_u8(pIn + i);
+        uint8x16x3_t chars;
+        chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+        chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+        chars.val[2] = vdupq_n_u8(' ');
+        vst3q_u8(reinterpret_cast<uint8_t*>(pOut + 3 * i), chars);
+    }
+    return i;
+
+} /* hexdump_hex_spaced_neon() */
+
+
+inline size_t hexdump_ascii_neon(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= szLen; i += 16) {
+        const uint8x16_t bytes     = vld1q_u8(pIn + i);
+        const uint8x16_t printable = vandq_u8(vcgeq_u8(bytes, vdupq_n_u8(0x20)), vcltq_u8(bytes, vdupq_n_u8(0x7F)));
+        vst1q_u8(reinterpret_cast<uint8_t*>(pOut + i), vbslq_u8(printable, bytes, vdupq_n_u8('.')));
+    }
+    return i;
+
+} /* hexdump_ascii_neon() */
+
+#endif /* uHEXDUMP_SIMD_X86 / uHEXDUMP_SIMD_NEON */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Selects the best column kernels supported by the running CPU (evaluated once).
+ * @return Reference to the selected kernels.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline const HexDumpKernels& hexdump_kernels()
+{
+    static const HexDumpKernels kernels = []() -> HexDumpKernels {
+#if defined(uHEXDUMP_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return { hexdump_hex_avx2, hexdump_hex_spaced_avx2, hexdump_ascii_avx2 };
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+            return { hexdump_hex_ssse3, hexdump_hex_spaced_ssse3, hexdump_ascii_ssse3 };
+        }
+#elif defined(uHEXDUMP_SIMD_NEON)
+        return { hexdump_hex_neon, hexdump_hex_spaced_neon, hexdump_ascii_neon };
+#endif
+        return { hexdump_column_scalar, hexdump_column_scalar, hexdump_column_scalar };
+    }();
+
+    return kernels;
+
+} /* hexdump_kernels() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns a copy of the options with HexDumpColor::Auto resolved against the destination.
+ * @param options The requested options.
+ * @param iFd File descriptor of the destination, negative when it is not a file.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline HexDumpOptions hexdump_resolve_color(const HexDumpOptions& options, int iFd) noexcept
+{
+    HexDumpOptions resolved = options;
+    resolved.eColor = hexdump_use_colors(options.eColor, iFd) ? HexDumpColor::Always : HexDumpColor::Never;
+    return resolved;
+
+} /* hexdump_resolve_color() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the file descriptor behind the standard streams, -1 for any other stream.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline int hexdump_stream_fd(const std::ostream& os) noexcept
+{
+    int iFd = -1;
+
+    if (os.rdbuf() == std::cout.rdbuf()) {
+        iFd = 1;
+    } else if ((os.rdbuf() == std::cerr.rdbuf()) || (os.rdbuf() == std::clog.rdbuf())) {
+        iFd = 2;
+    }
+
+    return iFd;
+
+} /* hexdump_stream_fd() */
+
+} // namespace internal
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @class HexDumpRenderer
+ * @brief Formats hexdump lines with table lookups into a large buffer, without the printf family.
+ *
+ * The text of every byte value (hex cell with its spacing and color escapes, ASCII cell) is prebuilt
+ * once per renderer; a line is then a sequence of fixed-size copies. When the cells carry no color
+ * escapes (colors off, or SectionColors and Plain styles) the columns are formatted 16/32 bytes at a
+ * time by the vectorized kernels selected at runtime, the cell tables only handle the remainder of the line.
+ * The line formatter is a template instantiated for every combination of the layout flags and picked
+ * once per renderer, so the loops carry no per-byte (or per-line) flag tests.
+ *
+ * HexDumpColor::Auto is resolved against the destination by the HexDump* functions; a renderer
+ * constructed directly treats it as Never. Whole blocks of lines are handed
+ * to a flush callback, so dumping to a FILE costs one fwrite() per block instead of one printf() per byte.
+ * The output is byte-identical to HexDump1, HexDump2 or HexDump3, depending on the style.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+class HexDumpRenderer
+{
+public:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Prepares the cell tables for a set of options.
+     * @param options Layout of the dump.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    explicit HexDumpRenderer(const HexDumpOptions& options = {})
+        : m_Options(options)
+    {
+        const bool bColors  = (HexDumpStyle::Plain != options.eStyle) && (HexDumpColor::Always == options.eColor);
+        const bool bPerByte = bColors && (HexDumpStyle::PerByteColors == options.eStyle);
+
+        if ((HexDumpStyle::SectionColors == options.eStyle) && (m_Options.szBytesPerLine > internal::g_szHexDumpMaxBytesPerLine2)) {
+            m_Options.szBytesPerLine = internal::g_szHexDumpMaxBytesPerLine2;
+        }
+
+        const HexDumpPalette& palette = options.palette;
+        m_strOffsetOpen  = bColors ? palette.strOffset : "";
+        m_strOffsetClose = bColors ? palette.strReset : "";
+        m_strHexOpen     = (bColors && !bPerByte) ? palette.strHex : "";
+        m_strHexClose    = (bColors && !bPerByte) ? palette.strReset : "";
+        m_strAsciiOpen   = std::string((bColors && !bPerByte) ? palette.strAscii : "").append(" | ");
+        m_strAsciiClose  = (bColors && !bPerByte) ? palette.strReset : "";
+        m_szPadding      = options.bShowSpaces ? 3 : 2;
+
+        // escapes too long for a cell are dropped rather than overflowing it
+        const size_t szEscapeRoom = internal::g_szHexDumpCellSize - 3;
+        const bool bHexCells   = bPerByte && (palette.strHex.size() + palette.strReset.size() <= szEscapeRoom);
+        const bool bAsciiCells = bPerByte && (palette.strAscii.size() + palette.strReset.size() <= szEscapeRoom);
+        const std::string_view strHexColor   = bHexCells ? palette.strHex : "";
+        const std::string_view strHexReset   = bHexCells ? palette.strReset : "";
+        const std::string_view strAsciiColor = bAsciiCells ? palette.strAscii : "";
+        const std::string_view strAsciiReset = bAsciiCells ? palette.strReset : "";
+
+        for (size_t b = 0; b < 256; ++b) {
+            char* pCell = internal::hexdump_append(m_acHexCells[b], strHexColor);
+            *pCell++ = internal::g_acHexDumpDigits[b >> 4];
+            *pCell++ = internal::g_acHexDumpDigits[b & 0xF];
+            if (options.bShowSpaces) {
+                *pCell++ = ' ';
+            }
+            pCell = internal::hexdump_append(pCell, strHexReset);
+            m_szHexCell = static_cast<size_t>(pCell - m_acHexCells[b]);
+
+            pCell = internal::hexdump_append(m_acAsciiCells[b], strAsciiColor);
+            *pCell++ = internal::hexdump_is_print(static_cast<uint8_t>(b)) ? static_cast<char>(b) : '.';
+            pCell = internal::hexdump_append(pCell, strAsciiReset);
+            m_szAsciiCell = static_cast<size_t>(pCell - m_acAsciiCells[b]);
+        }
+
+        const size_t szBpl = m_Options.szBytesPerLine;
+        if (!bPerByte) {
+            const internal::HexDumpKernels& kernels = internal::hexdump_kernels();
+            m_pfnHexColumn   = options.bShowSpaces ? kernels.pfnHexSpaced : kernels.pfnHex;
+            m_pfnAsciiColumn = kernels.pfnAscii;
+        }
+
+        static const std::array<RenderLineFn, 32> apfnRenderLine = make_render_line_table(std::make_index_sequence<32>{});
+        m_pfnRenderLine = apfnRenderLine[(options.bShowOffset ? 1U : 0U) | (options.bDecimalOffset ? 2U : 0U) |
+                                         (options.bShowSpaces ? 4U : 0U) | (options.bShowAscii ? 8U : 0U) | (bPerByte ? 16U : 0U)];
+
+        m_szMaxLineSize = m_strOffsetOpen.size() + 20 + 3 + m_strOffsetClose.size() +
+                          m_strHexOpen.size() + szBpl * std::max(m_szHexCell, m_szPadding) + m_strHexClose.size() +
+                          m_strAsciiOpen.size() + szBpl * m_szAsciiCell + m_strAsciiClose.size() + 1 +
+                          internal::g_szHexDumpCellSize;
+    }
+
+
+    /**
+     * @brief Returns the effective number of bytes per line (HexDump2 caps it at 96).
+     */
+    size_t bytes_per_line() const noexcept { return m_Options.szBytesPerLine; }
+
+    /**
+     * @brief Returns the room render_line() needs, cell overshoot included.
+     */
+    size_t max_line_size() const noexcept { return m_szMaxLineSize; }
+
+    /**
+     * @brief Changes the value added to the displayed offsets, e.g. for the successive chunks of a file.
+     */
+    void set_base_offset(size_t szBaseOffset) noexcept { m_Options.szBaseOffset = szBaseOffset; }
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Formats one line.
+     * @param pLine The bytes of the line.
+     * @param szLineLen Number of bytes in the line, at most bytes_per_line().
+     * @param szOffset The offset displayed for the line.
+     * @param pOut Output position, must have max_line_size() characters of room.
+     * @return The position after the line (newline included).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    char* render_line(const uint8_t* pLine, size_t szLineLen, size_t szOffset, char* pOut) const noexcept
+    {
+        return m_pfnRenderLine(*this, pLine, szLineLen, szOffset, pOut);
+
+    } /* render_line() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Formats a whole buffer, handing the text to fnFlush block by block.
+     * @param pData Pointer to the data buffer to be dumped.
+     * @param szDataSize Size of the data buffer in bytes.
+     * @param fnFlush Called as fnFlush(const char* pText, size_t szLen) for every filled block.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename Flush>
+    void render(const uint8_t* pData, size_t szDataSize, Flush&& fnFlush) const
+    {
+        const size_t szBpl = m_Options.szBytesPerLine;
+        if ((0 == szBpl) || (0 == szDataSize)) {
+            return;
+        }
+
+        std::vector<char> vBuffer(std::max(internal::g_szHexDumpBufferSize, 2 * m_szMaxLineSize));
+        char* const pBegin = vBuffer.data();
+        const char* const pLimit = pBegin + vBuffer.size() - m_szMaxLineSize;
+        char* pOut = pBegin;
+
+        bool bInRun = false;
+        for (size_t i = 0; i < szDataSize; i += szBpl) {
+            if (pOut > pLimit) {
+                fnFlush(static_cast<const char*>(pBegin), static_cast<size_t>(pOut - pBegin));
+                pOut = pBegin;
+            }
+            pOut = emit_line(pData, szDataSize, i, bInRun, pOut);
+        }
+
+        if (pOut != pBegin) {
+            fnFlush(static_cast<const char*>(pBegin), static_cast<size_t>(pOut - pBegin));
+        }
+
+    } /* render() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Dumps a buffer to a FILE stream, one fwrite() per block.
+     * @param pData Pointer to the data buffer to be dumped.
+     * @param szDataSize Size of the data buffer in bytes.
+     * @param pFile The output stream (default is stdout).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    void dump(const uint8_t* pData, size_t szDataSize, std::FILE* pFile = stdout) const
+    {
+        render(pData, szDataSize, [pFile](const char* pText, size_t szLen) {
+            std::fwrite(pText, 1, szLen, pFile);
+        });
+
+    } /* dump() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Hands every line to fnLine as a view into the renderer's line buffer (no copy, no allocation per line).
+     * @param pData Pointer to the data buffer to be dumped.
+     * @param szDataSize Size of the data buffer in bytes.
+     * @param fnLine Called as fnLine(std::string_view line) for every line, without the newline;
+     *        the view is only valid during the call.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename LineFn>
+    void render_lines(const uint8_t* pData, size_t szDataSize, LineFn&& fnLine) const
+    {
+        const size_t szBpl = m_Options.szBytesPerLine;
+        if ((0 == szBpl) || (0 == szDataSize)) {
+            return;
+        }
+
+        std::vector<char> vLine(m_szMaxLineSize);
+        bool bInRun = false;
+        for (size_t i = 0; i < szDataSize; i += szBpl) {
+            const char* pEnd = emit_line(pData, szDataSize, i, bInRun, vLine.data());
+            if (pEnd != vLine.data()) {
+                fnLine(std::string_view(vLine.data(), static_cast<size_t>(pEnd - vLine.data()) - 1));
+            }
+        }
+
+    } /* render_lines() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Appends the dump to a string, formatting the lines in place (no intermediate buffer).
+     * @tparam String std::string, std::pmr::string or any std::basic_string<char> specialization.
+     * @param pData Pointer to the data buffer to be dumped.
+     * @param szDataSize Size of the data buffer in bytes.
+     * @param str The string receiving the dump.
+     * @param szBegin Only the lines starting in [szBegin, szEnd) are formatted; szBegin is a multiple of bytes_per_line().
+     *        Squeezing looks at the data before szBegin, so ranges formatted apart join into the full dump.
+     * @param szEnd End of the range of line starts (default: the whole buffer).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<typename String>
+    void render_into(const uint8_t* pData, size_t szDataSize, String& str, size_t szBegin = 0, size_t szEnd = SIZE_MAX) const
+    {
+        const size_t szBpl = m_Options.szBytesPerLine;
+        szEnd = std::min(szEnd, szDataSize);
+        if ((0 == szBpl) || (szBegin >= szEnd)) {
+            return;
+        }
+
+        const size_t szBlockLines = std::max<size_t>(internal::g_szHexDumpBufferSize / m_szMaxLineSize, 1);
+        size_t szUsed = str.size();
+        bool bInRun = m_Options.bSqueeze && (szBegin >= szBpl) && internal::hexdump_is_repeat(pData, szDataSize, szBegin - szBpl, szBpl);
+
+        for (size_t i = szBegin; i < szEnd; ) {
+            const size_t szLines = std::min(szBlockLines, (szEnd - i + szBpl - 1) / szBpl);
+            str.resize(szUsed + szLines * m_szMaxLineSize);
+            char* const pBegin = str.data();
+            char* pOut = pBegin + szUsed;
+            for (size_t k = 0; k < szLines; ++k, i += szBpl) {
+                pOut = emit_line(pData, szDataSize, i, bInRun, pOut);
+            }
+            szUsed = static_cast<size_t>(pOut - pBegin);
+        }
+
+        str.resize(szUsed);
+
+    } /* render_into() */
+
+
+private:
+
+    using RenderLineFn = char* (*)(const HexDumpRenderer&, const uint8_t*, size_t, size_t, char*) noexcept;
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Formats the line starting at szLineStart, or the "*" marker opening a squeezed run, or nothing
+     *        inside a run.
+     * @param bInRun Squeeze state carried from one line to the next.
+     * @return The position after the written text.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    char* emit_line(const uint8_t* pData, size_t szDataSize, size_t szLineStart, bool& bInRun, char* pOut) const noexcept
+    {
+        const size_t szBpl = m_Options.szBytesPerLine;
+
+        if (m_Options.bSqueeze && internal::hexdump_is_repeat(pData, szDataSize, szLineStart, szBpl)) {
+            if (!bInRun) {
+                bInRun = true;
+                *pOut++ = '*';
+                *pOut++ = '\n';
+            }
+            return pOut;
+        }
+
+        bInRun = false;
+        return m_pfnRenderLine(*this, pData + szLineStart, std::min(szBpl, szDataSize - szLineStart), m_Options.szBaseOffset + szLineStart, pOut);
+
+    } /* emit_line() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief The line formatter, specialized on the layout flags.
+     * @tparam bOffset Offset column.
+     * @tparam bDecimal Decimal offsets.
+     * @tparam bSpaces Space after every hex byte (3-character hex cells instead of 2).
+     * @tparam bAscii ASCII column.
+     * @tparam bCellEscapes Every cell carries its own color escapes (PerByteColors with colors on).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    template<bool bOffset, bool bDecimal, bool bSpaces, bool bAscii, bool bCellEscapes>
+    static char* render_line_impl(const HexDumpRenderer& self, const uint8_t* pLine, size_t szLineLen, size_t szOffset, char* pOut) noexcept
+    {
+        constexpr size_t szPlainHexCell = bSpaces ? 3 : 2;
+
+        if constexpr (bOffset) {
+            pOut = internal::hexdump_append(pOut, self.m_strOffsetOpen);
+            pOut = internal::hexdump_offset(pOut, szOffset, bDecimal);
+            std::memcpy(pOut, " | ", 3);
+            pOut += 3;
+            pOut = internal::hexdump_append(pOut, self.m_strOffsetClose);
+        }
+
+        pOut = internal::hexdump_append(pOut, self.m_strHexOpen);
+        if constexpr (bCellEscapes) {
+            for (size_t j = 0; j < szLineLen; ++j) {
+                std::memcpy(pOut, self.m_acHexCells[pLine[j]], internal::g_szHexDumpCellSize);
+                pOut += self.m_szHexCell;
+            }
+        } else {
+            const size_t szDone = self.m_pfnHexColumn(pLine, szLineLen, pOut);
+            pOut += szDone * szPlainHexCell;
+            for (size_t j = szDone; j < szLineLen; ++j) {
+                std::memcpy(pOut, self.m_acHexCells[pLine[j]], 4);
+                pOut += szPlainHexCell;
+            }
+        }
+        const size_t szPadding = (self.m_Options.szBytesPerLine - szLineLen) * szPlainHexCell;
+        std::memset(pOut, ' ', szPadding);
+        pOut += szPadding;
+        pOut = internal::hexdump_append(pOut, self.m_strHexClose);
+
+        if constexpr (bAscii) {
+            pOut = internal::hexdump_append(pOut, self.m_strAsciiOpen);
+            if constexpr (bCellEscapes) {
+                for (size_t j = 0; j < szLineLen; ++j) {
+                    std::memcpy(pOut, self.m_acAsciiCells[pLine[j]], internal::g_szHexDumpCellSize);
+                    pOut += self.m_szAsciiCell;
                 }
             } else {
-                ossline << (bShowSpaces ? "   " : "  ");
+                const size_t szDone = self.m_pfnAsciiColumn(pLine, szLineLen, pOut);
+                pOut += szDone;
+                for (size_t j = szDone; j < szLineLen; ++j) {
+                    *pOut++ = self.m_acAsciiCells[pLine[j]][0];
+                }
             }
+            pOut = internal::hexdump_append(pOut, self.m_strAsciiClose);
         }
 
-        /* ASCII characters */
-        if (bShowAscii) {
-            ossline << " | ";
-            for (size_t j = 0; j < szLineLen; ++j) {
-                uint8_t ch = pData[szLineStart + j];
-                ossline << (std::isprint(ch) ? static_cast<char>(ch) : '.');
+        *pOut++ = '\n';
+        return pOut;
+
+    } /* render_line_impl() */
+
+
+    /**
+     * @brief Builds the table of the 32 line formatters, indexed by the flag bits
+     *        (1 offset, 2 decimal, 4 spaces, 8 ascii, 16 cell escapes).
+     */
+    template<size_t... I>
+    static constexpr std::array<RenderLineFn, 32> make_render_line_table(std::index_sequence<I...>) noexcept
+    {
+        return { &render_line_impl<(0 != (I & 1)), (0 != (I & 2)), (0 != (I & 4)), (0 != (I & 8)), (0 != (I & 16))>... };
+    }
+
+
+    HexDumpOptions m_Options;                                   ///< Layout of the dump.
+    std::string_view m_strOffsetOpen;                           ///< Written before the offset.
+    std::string_view m_strOffsetClose;                          ///< Written after the offset separator.
+    std::string_view m_strHexOpen;                              ///< Written before the hex section.
+    std::string_view m_strHexClose;                             ///< Written after the hex section.
+    std::string m_strAsciiOpen;                                 ///< Written before the ASCII section (separator included).
+    std::string_view m_strAsciiClose;                           ///< Written after the ASCII section.
+    size_t m_szPadding = 3;                                     ///< Blanks per missing byte of a short line.
+    size_t m_szHexCell = 0;                                     ///< Useful length of a hex cell.
+    size_t m_szAsciiCell = 0;                                   ///< Useful length of an ASCII cell.
+    size_t m_szMaxLineSize = 0;                                 ///< Room needed by render_line().
+    internal::HexDumpColumnFn m_pfnHexColumn = internal::hexdump_column_scalar;    ///< Vectorized hex column, if the cells allow it.
+    internal::HexDumpColumnFn m_pfnAsciiColumn = internal::hexdump_column_scalar;  ///< Vectorized ASCII column, if the cells allow it.
+    RenderLineFn m_pfnRenderLine = nullptr;                     ///< Line formatter specialized on the layout.
+    char m_acHexCells[256][internal::g_szHexDumpCellSize];      ///< Text of every byte in the hex section.
+    char m_acAsciiCells[256][internal::g_szHexDumpCellSize];    ///< Text of every byte in the ASCII section.
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Hexdump sinks: callables taking (const char* pText, size_t szLen), handed whole blocks of lines
+ *        by HexDumpRenderer::render() and HexDumpTo(). Any lambda with that signature is a sink as well.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Sink appending to a std::string, std::pmr::string or any std::basic_string<char>.
+ */
+template<typename String>
+class HexDumpStringSink
+{
+public:
+    explicit HexDumpStringSink(String& str) : m_str(str) {}
+    void operator()(const char* pText, size_t szLen) { m_str.append(pText, szLen); }
+
+private:
+    String& m_str;  ///< The string receiving the dump.
+};
+
+
+/**
+ * @brief Sink writing to a std::ostream.
+ */
+class HexDumpStreamSink
+{
+public:
+    explicit HexDumpStreamSink(std::ostream& os) : m_os(os) {}
+    void operator()(const char* pText, size_t szLen) { m_os.write(pText, static_cast<std::streamsize>(szLen)); }
+
+private:
+    std::ostream& m_os;  ///< The stream receiving the dump.
+};
+
+
+/**
+ * @brief Sink writing to a FILE stream.
+ */
+class HexDumpFileSink
+{
+public:
+    explicit HexDumpFileSink(std::FILE* pFile) : m_pFile(pFile) {}
+    void operator()(const char* pText, size_t szLen) { std::fwrite(pText, 1, szLen, m_pFile); }
+
+private:
+    std::FILE* m_pFile;  ///< The stream receiving the dump.
+};
+
+
+/**
+ * @brief Sink writing to a raw file descriptor (partial writes and EINTR are retried); remembers the errno of
+ *        the first failed write (EIO for a write of 0 bytes) and writes nothing after it.
+ */
+class HexDumpFdSink
+{
+public:
+    explicit HexDumpFdSink(int iFd) : m_iFd(iFd) {}
+
+    void operator()(const char* pText, size_t szLen)
+    {
+        while ((0 == m_iError) && (szLen > 0)) {
+#if defined(_WIN32)
+            const int iWritten = _write(m_iFd, pText, static_cast<unsigned int>(std::min<size_t>(szLen, 0x40000000)));
+#else
+            const ssize_t iWritten = write(m_iFd, pText, szLen);
+#endif
+            if (iWritten < 0) {
+                m_iError = (EINTR == errno) ? 0 : errno;
+                continue;
+            }
+            if (0 == iWritten) {
+                m_iError = EIO;
+                continue;
+            }
+            pText += iWritten;
+            szLen -= static_cast<size_t>(iWritten);
+        }
+    }
+
+    bool ok() const noexcept { return 0 == m_iError; }
+    int error() const noexcept { return m_iError; }
+
+private:
+    int m_iFd;          ///< The file descriptor receiving the dump.
+    int m_iError = 0;   ///< errno of the first failed write, 0 while all succeeded.
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Dumps a buffer to a sink, block by block.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param sink Callable taking (const char* pText, size_t szLen), see the HexDump*Sink classes.
+ * @param options Layout of the dump.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Sink>
+inline void HexDumpTo(const uint8_t* pData, size_t szDataSize, Sink&& sink, const HexDumpOptions& options = {})
+{
+    HexDumpRenderer(internal::hexdump_resolve_color(options, -1)).render(pData, szDataSize, sink);
+
+} /* HexDumpTo() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Appends a dump to a string, the lines being formatted directly into its storage.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param str std::string, std::pmr::string or any std::basic_string<char> receiving the dump.
+ * @param options Layout of the dump.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename String>
+inline void HexDumpToString(const uint8_t* pData, size_t szDataSize, String& str, const HexDumpOptions& options = {})
+{
+    HexDumpRenderer(internal::hexdump_resolve_color(options, -1)).render_into(pData, szDataSize, str);
+
+} /* HexDumpToString() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns a dump as a string.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param options Layout of the dump.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline std::string HexDumpString(const uint8_t* pData, size_t szDataSize, const HexDumpOptions& options = {})
+{
+    std::string str;
+    HexDumpToString(pData, szDataSize, str, options);
+    return str;
+
+} /* HexDumpString() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Writes a dump to a std::ostream, one write() per block.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param os The stream receiving the dump.
+ * @param options Layout of the dump.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void HexDumpToStream(const uint8_t* pData, size_t szDataSize, std::ostream& os, const HexDumpOptions& options = {})
+{
+    HexDumpRenderer(internal::hexdump_resolve_color(options, internal::hexdump_stream_fd(os))).render(pData, szDataSize, HexDumpStreamSink(os));
+
+} /* HexDumpToStream() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Writes a dump to a raw file descriptor, one write() per block.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param iFd The file descriptor receiving the dump.
+ * @param options Layout of the dump.
+ * @return False if a write failed.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool HexDumpToFd(const uint8_t* pData, size_t szDataSize, int iFd, const HexDumpOptions& options = {})
+{
+    HexDumpFdSink sink(iFd);
+    HexDumpRenderer(internal::hexdump_resolve_color(options, iFd)).render(pData, szDataSize, sink);
+    return sink.ok();
+
+} /* HexDumpToFd() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Hands a dump to a callback line by line, as views into the renderer's buffer.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param fnLine Called as fnLine(std::string_view line) for every line, without the newline;
+ *        the view is only valid during the call.
+ * @param options Layout of the dump.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename LineFn>
+inline void HexDumpLines(const uint8_t* pData, size_t szDataSize, LineFn&& fnLine, const HexDumpOptions& options = {})
+{
+    HexDumpRenderer(internal::hexdump_resolve_color(options, -1)).render_lines(pData, szDataSize, fnLine);
+
+} /* HexDumpLines() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Tuning of HexDumpParallel.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+struct HexDumpParallelOptions {
+    size_t szBlockSize = internal::g_szHexDumpParallelBlockSize;  /**< Input bytes formatted per task, rounded down to whole lines */
+    size_t szThreshold = internal::g_szHexDumpParallelThreshold;  /**< Inputs smaller than this are formatted on the calling thread */
+    unsigned uThreads  = 0;                                       /**< Maximum number of threads, 0 for std::thread::hardware_concurrency() */
+    size_t szMaxBufferedBlocks = 0;                               /**< Formatted blocks held at once (memory bound), 0 for twice the threads */
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Dumps a large buffer to a sink using several threads, the output being identical to HexDumpTo().
+ *
+ * The input is split in line-aligned blocks; worker threads format them into per-block buffers and the
+ * calling thread hands the buffers to the sink strictly in order (helping with the formatting while the
+ * next block is not ready). At most szMaxBufferedBlocks formatted blocks exist at any time, so the memory
+ * use is bounded by that number times the text size of one block, whatever the input size. If a thread
+ * cannot be started, the already running ones (or the calling thread alone) do the work. An exception
+ * thrown while formatting (e.g. std::bad_alloc) stops the dump and is rethrown on the calling thread once
+ * the workers are joined, as the serial path would throw it.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param sink Callable taking (const char* pText, size_t szLen), called once per block, in order.
+ * @param options Layout of the dump (HexDumpColor::Auto means no colors).
+ * @param parallel Block size, threads and memory bound.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Sink>
+inline void HexDumpParallelTo(const uint8_t* pData, size_t szDataSize, Sink&& sink, const HexDumpOptions& options = {},
+                              const HexDumpParallelOptions& parallel = {})
+{
+    const HexDumpRenderer renderer(internal::hexdump_resolve_color(options, -1));
+    const size_t szBpl = renderer.bytes_per_line();
+
+    unsigned uThreads = (0 != parallel.uThreads) ? parallel.uThreads : std::thread::hardware_concurrency();
+    if (0 == uThreads) {
+        uThreads = 1;
+    }
+
+    if ((0 == szBpl) || (0 == szDataSize)) {
+        return;
+    }
+    if ((szDataSize < parallel.szThreshold) || (1 == uThreads)) {
+        renderer.render(pData, szDataSize, sink);
+        return;
+    }
+
+    const size_t szBlockSize = std::max(szBpl, (parallel.szBlockSize / szBpl) * szBpl);
+    const size_t szBlocks    = (szDataSize + szBlockSize - 1) / szBlockSize;
+    const size_t szWindow    = std::max<size_t>(1, (0 != parallel.szMaxBufferedBlocks) ? parallel.szMaxBufferedBlocks : 2 * size_t(uThreads));
+
+    struct Slot {
+        std::string strText;
+        bool bReady = false;
+    };
+    std::vector<Slot> vSlots(szWindow);
+    std::mutex mtx;
+    std::condition_variable cvReady;
+    std::condition_variable cvFree;
+    size_t szNextBlock = 0;   // next block to format, guarded by mtx
+    size_t szEmitted   = 0;   // blocks handed to the sink, guarded by mtx
+    bool bAbort        = false;
+    std::exception_ptr pError;  // first exception of a worker, guarded by mtx
+
+    auto claimable = [&]() { return (szNextBlock < szBlocks) && (szNextBlock < szEmitted + szWindow); };
+
+    /* formats a claimed block, called without the lock held */
+    auto format = [&](size_t szBlock) {
+        Slot& slot = vSlots[szBlock % szWindow];
+        const size_t szBegin = szBlock * szBlockSize;
+        slot.strText.clear();
+        renderer.render_into(pData, szDataSize, slot.strText, szBegin, szBegin + szBlockSize);
+    };
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mtx);
+        for (;;) {
+            cvFree.wait(lock, [&]() { return bAbort || (szNextBlock >= szBlocks) || claimable(); });
+            if (bAbort || (szNextBlock >= szBlocks)) {
+                break;
+            }
+            const size_t szBlock = szNextBlock++;
+            lock.unlock();
+            try {
+                format(szBlock);
+            } catch (...) {
+                // the block will never be ready: stop handing out blocks and wake the calling thread
+                lock.lock();
+                if (nullptr == pError) {
+                    pError = std::current_exception();
+                }
+                bAbort = true;
+                cvReady.notify_all();
+                cvFree.notify_all();
+                break;
             }
+            lock.lock();
+            vSlots[szBlock % szWindow].bReady = true;
+            cvReady.notify_all();
         }
+    };
+
+    std::vector<std::thread> vThreads;
+    vThreads.reserve(uThreads - 1);
+    for (unsigned i = 1; i < uThreads; ++i) {
+        try {
+            vThreads.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+
+    auto join = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            bAbort = true;
+        }
+        cvFree.notify_all();
+        for (std::thread& thread : vThreads) {
+            thread.join();
+        }
+    };
+
+    try {
+        for (size_t szBlock = 0; szBlock < szBlocks; ++szBlock) {
+            Slot& slot = vSlots[szBlock % szWindow];
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                while (!slot.bReady) {
+                    if (nullptr != pError) {
+                        std::rethrow_exception(pError);
+                    }
+                    if (claimable()) {
+                        const size_t szClaimed = szNextBlock++;
+                        lock.unlock();
+                        format(szClaimed);
+                        lock.lock();
+                        vSlots[szClaimed % szWindow].bReady = true;
+                    } else {
+                        cvReady.wait(lock);
+                    }
+                }
+            }
+
+            /* no worker touches the slot until szEmitted moves past it */
+            sink(static_cast<const char*>(slot.strText.data()), slot.strText.size());
+
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                slot.bReady = false;
+                szEmitted = szBlock + 1;
+            }
+            cvFree.notify_all();
+        }
+    } catch (...) {
+        join();
+        throw;
+    }
+
+    join();
+
+} /* HexDumpParallelTo() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Dumps a large buffer to a FILE stream using several threads, see HexDumpParallelTo().
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param options Layout of the dump.
+ * @param parallel Block size, threads and memory bound.
+ * @param pFile The output stream (default is stdout).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void HexDumpParallel(const uint8_t* pData, size_t szDataSize, const HexDumpOptions& options = {},
+                            const HexDumpParallelOptions& parallel = {}, std::FILE* pFile = stdout)
+{
+    HexDumpParallelTo(pData, szDataSize, HexDumpFileSink(pFile),
+                      internal::hexdump_resolve_color(options, internal::hexdump_fileno(pFile)), parallel);
+
+} /* HexDumpParallel() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Outputs a formatted hexadecimal dump of a block of memory through the buffered renderer.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param options Layout of the dump; the style selects which of HexDump1/2/3 the output matches.
+ * @param pFile The output stream (default is stdout).
+ *
+ * @note Needs about 72 KB of heap for its buffer and tables, unlike HexDump1 and HexDump2.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void HexDumpBuffered(const uint8_t* pData, size_t szDataSize, const HexDumpOptions& options = {}, std::FILE* pFile = stdout)
+{
+    HexDumpRenderer(internal::hexdump_resolve_color(options, internal::hexdump_fileno(pFile))).dump(pData, szDataSize, pFile);
+
+} /* HexDumpBuffered() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Outputs a buffered hexadecimal dump using a flag string for customization, see HexDump1S().
+ *        Like HexDump1S() and HexDump2S(), the colors follow HexDumpSetColor().
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param szBytesPerLine Number of bytes to display per line.
+ * @param flagString A string containing formatting flags to control the output style.
+ * @param eStyle Selects which of HexDump1/2/3 the output matches.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void HexDumpBufferedS(const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine = 16, const std::string& flagString = "",
+                             HexDumpStyle eStyle = HexDumpStyle::PerByteColors)
+{
+    HexDumpOptions options;
+    options.szBytesPerLine = szBytesPerLine;
+    options.eStyle = eStyle;
+    options.eColor = internal::g_eHexDumpColor.load();
 
-        std::printf("%s\n", ossline.str().c_str());
+    if (HexDumpParseFlags(flagString, options)) {
+        HexDumpBuffered(pData, szDataSize, options);
     }
 
-} /*HexDump3() */
+} /* HexDumpBufferedS() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Outputs a formatted hexadecimal dump of a block of memory.
+ *
+ * This function prints the contents of a memory block in a human-readable
+ * hexadecimal format. It can optionally include ASCII representation,
+ * byte offsets, and spacing between bytes.
+ *
+ * @param pData Pointer to the data buffer to be dumped.
+ * @param szDataSize Size of the data buffer in bytes.
+ * @param szBytesPerLine Number of bytes to display per line (default is 16).
+ * @param bShowSpaces If true, inserts spaces between bytes for readability (default is true).
+ * @param bShowAscii If true, appends ASCII representation of bytes to each line (default is true).
+ * @param bShowOffset If true, displays the offset at the beginning of each line (default is true).
+ * @param bDecimalOffset If true, displays the offset in decimal instead of hexadecimal (default is false).
+ *
+ * @note This C++ variant formats whole blocks of lines before printing them (see HexDumpRenderer).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void HexDump3 ( const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine = 16, bool bShowSpaces = true, bool bShowAscii = true, bool bShowOffset = true, bool bDecimalOffset = false )
+{
+    HexDumpOptions options;
+    options.szBytesPerLine = szBytesPerLine;
+    options.bShowSpaces = bShowSpaces;
+    options.bShowAscii = bShowAscii;
+    options.bShowOffset = bShowOffset;
+    options.bDecimalOffset = bDecimalOffset;
+    options.eStyle = HexDumpStyle::Plain;
+
+    HexDumpRenderer(options).dump(pData, szDataSize);
+
+} /* HexDump3() */
 
 
 
@@ -369,32 +1928,15 @@ inline void HexDump3 ( const uint8_t* pData, size_t szDataSize, size_t szBytesPe
 
 inline void HexDump3S ( const uint8_t* pData, size_t szDataSize, size_t szBytesPerLine = 16, const std::string& flagString = "" )
 {
-    bool bShowSpaces = true;
-    bool bShowAscii = true;
-    bool bShowOffset = true;
-    bool bDecimalOffset = false;
+    HexDumpOptions options;
 
-    if(!flagString.empty()) {
-        try {
-            FlagParser flags(flagString);
-
-            if (flagString.find_first_of("sS") != std::string::npos)
-                bShowSpaces = flags.get_flag('S');
-            if (flagString.find_first_of("aA") != std::string::npos)
-                bShowAscii = flags.get_flag('A');
-            if (flagString.find_first_of("oO") != std::string::npos)
-                bShowOffset = flags.get_flag('O');
-            if (flagString.find_first_of("dD") != std::string::npos)
-                bDecimalOffset = flags.get_flag('D');
-        } catch (const std::exception& e) {
-            std::printf("Invalid flag string: %s\n", e.what());
-            return;
-        }
+    if (HexDumpParseFlags(flagString, options)) {
+        options.szBytesPerLine = szBytesPerLine;
+        options.eStyle = HexDumpStyle::Plain;
+        HexDumpRenderer(options).dump(pData, szDataSize);
     }
 
-    HexDump3(pData, szDataSize, szBytesPerLine, bShowSpaces, bShowAscii, bShowOffset, bDecimalOffset);
-
-} /* HexDump3() */
+} /* HexDump3S() */
 
 } // namespace hexutils
 
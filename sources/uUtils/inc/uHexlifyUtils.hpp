@@ -1,12 +1,44 @@
 #ifndef UHEXLIFYUTILS_HPP
 #define UHEXLIFYUTILS_HPP
 
+#ifndef uHEXLIFY_USE_SIMD
+    #define uHEXLIFY_USE_SIMD   1U
+#endif
+
 #include <vector>
 #include <string>
-#include <stdexcept>
+#include <string_view>
+#include <span>
+#include <array>
 #include <cstring>
+#include <cstdint>
 #include <type_traits>
 #include <algorithm>
+#include <iterator>
+#include <bit>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <thread>
+#include <atomic>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+#if (1 == uHEXLIFY_USE_SIMD)
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #define uHEXLIFY_SIMD_X86     1
+        #include <immintrin.h>
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #define uHEXLIFY_SIMD_NEON    1
+        #include <arm_neon.h>
+    #endif
+#endif /* (1 == uHEXLIFY_USE_SIMD) */
 
 
 /*--------------------------------------------------------------------------------------------------------*/
@@ -27,6 +59,43 @@ enum class Endianness {
     Big     /**< Big-endian format */
 };
 
+/**
+ * @brief Status codes reported by the non-throwing hex decoders.
+ */
+enum class HexStatus {
+    Ok,             /**< Conversion successful */
+    OddLength,      /**< The input has an odd number of characters */
+    InvalidChar,    /**< The input contains a character which is not a hexadecimal digit */
+    BufferTooSmall, /**< The output buffer cannot hold the decoded data */
+    InvalidMarker,  /**< The endianness marker is missing or unknown */
+    SizeMismatch    /**< The decoded data is not a whole number of elements */
+};
+
+/**
+ * @brief Outcome of a non-throwing hex decode.
+ */
+struct HexResult {
+    HexStatus eStatus     = HexStatus::Ok; /**< Status of the conversion */
+    size_t szWritten      = 0;             /**< Number of bytes written to the output */
+    size_t szErrorOffset  = 0;             /**< Offset in the input of the first offending character (errors only) */
+
+    explicit operator bool() const noexcept { return HexStatus::Ok == eStatus; }
+};
+
+/**
+ * @brief Layout of the hexadecimal text produced by the formatting string_hexlify() overloads.
+ *
+ * Bytes are written as [prefix]XX. Consecutive bytes of a group are joined by strSeparator, consecutive
+ * groups by strGroupSeparator, e.g. {"0x", ", "} gives "0xAA, 0xBB" and {"", "", 4, " "} gives "AABBCCDD EEFF".
+ */
+struct HexFormat {
+    std::string_view strBytePrefix;      /**< Written before every byte, e.g. "0x" */
+    std::string_view strSeparator;       /**< Written between the bytes of a group, e.g. ":" */
+    size_t szGroupSize = 0;              /**< Bytes per group, 0 for a single group */
+    std::string_view strGroupSeparator;  /**< Written between groups (instead of strSeparator), e.g. " " */
+    bool bLowercase = false;             /**< Lowercase digits */
+};
+
 /*--------------------------------------------------------------------------------------------------------*/
 /**
  * @namespace internal
@@ -36,20 +105,65 @@ enum class Endianness {
 namespace internal
 {
 constexpr char g_pstrHexDigits[] = "0123456789ABCDEF";
+constexpr char g_pstrHexDigitsLower[] = "0123456789abcdef";
+
+/**
+ * @brief Number of bytes converted per step by the output iterator variants (staged on the stack).
+ */
+constexpr size_t g_szHexBlockSize = 256;
+
+/**
+ * @brief Default number of input bytes read per step by the streaming adapters.
+ */
+constexpr size_t g_szHexStreamChunkSize = 64 * 1024;
+
+/**
+ * @brief Number of bytes byte-swapped and converted per step by the *_any functions (kept hot in L1).
+ */
+constexpr size_t g_szSwapBlockSize = 4096;
+
+/**
+ * @brief Length of a run of digits (in bytes) from which the tolerant decoder hands the next runs to the vector kernel.
+ */
+constexpr size_t g_szHexKernelRun = 16;
+
+/**
+ * @brief Longest separator + prefix + digits emitted per byte through the prebuilt cell table of hex_format_bytes().
+ */
+constexpr size_t g_szHexCellSize = 16;
+
+/**
+ * @brief Number of bytes from which hex_format_bytes() prebuilds its cell table.
+ */
+constexpr size_t g_szHexCellTableMin = 256;
+
+/**
+ * @brief Marks the separator characters in g_au8HexTolerantTable.
+ */
+constexpr uint8_t g_u8HexSeparatorChar = 0xFE;
+
+/**
+ * @brief Default number of input bytes encoded per task by the parallel hexlify (fits in L2 with its output).
+ */
+constexpr size_t g_szParallelChunkSize = 256 * 1024;
+
+/**
+ * @brief Default input size below which the parallel hexlify stays on the calling thread.
+ */
+constexpr size_t g_szParallelThreshold = 8 * 1024 * 1024;
 
 
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Checks if the system is little-endian.
+ * @brief Checks if the system is little-endian (resolved at compile time).
  * @return True if the system is little-endian, false otherwise.
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-bool is_system_little_endian()
+constexpr bool is_system_little_endian() noexcept
 {
-    uint16_t test = 0x1;
-    return *reinterpret_cast<uint8_t*>(&test) == 0x1;
+    return std::endian::native == std::endian::little;
 
 } /* is_system_little_endian() */
 
@@ -57,223 +171,2282 @@ bool is_system_little_endian()
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Converts a hexadecimal character to its byte value.
+ * @brief Tells whether elements have to be byte-swapped to be stored with the given endianness.
+ * @tparam E The target endianness.
+ * @tparam T The element type.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<Endianness E, typename T>
+constexpr bool needs_byteswap() noexcept
+{
+    constexpr std::endian target = (E == Endianness::Little) ? std::endian::little : std::endian::big;
+    return (sizeof(T) > 1) && (target != std::endian::native);
+
+} /* needs_byteswap() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the marker byte which prefixes the string_hexlify_any() output: 'L' or 'B'.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+constexpr uint8_t endianness_marker(Endianness endian) noexcept
+{
+    return (endian == Endianness::Little) ? 0x4C : 0x42;
+
+} /* endianness_marker() */
+
+
+
+/**
+ * @brief Marks the characters of g_au8HexDecodeTable which are not hexadecimal digits.
+ */
+constexpr uint8_t g_u8InvalidHexChar = 0xFF;
+
+/**
+ * @brief Maps every character to its nibble value, or to g_u8InvalidHexChar if it is not a hexadecimal digit.
+ */
+constexpr std::array<uint8_t, 256> g_au8HexDecodeTable = []() {
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = g_u8InvalidHexChar;
+    }
+    for (uint8_t i = 0; i < 10; ++i) {
+        table['0' + i] = i;
+    }
+    for (uint8_t i = 0; i < 6; ++i) {
+        table['A' + i] = static_cast<uint8_t>(10 + i);
+        table['a' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return table;
+}();
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a hexadecimal character to its nibble value.
  * @param c The hexadecimal character.
- * @return The byte value of the hexadecimal character.
- * @throws std::invalid_argument if the character is not a valid hexadecimal character.
+ * @return The nibble value (0..15), or g_u8InvalidHexChar if the character is not a valid hexadecimal character.
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-uint8_t hex_char_to_byte(char c)
+constexpr uint8_t hex_char_to_byte(char c) noexcept
 {
-    if ('0' <= c && c <= '9') return c - '0';
-    if ('A' <= c && c <= 'F') return c - 'A' + 10;
-    if ('a' <= c && c <= 'f') return c - 'a' + 10;
-    throw std::invalid_argument("Invalid hex character");
+    return g_au8HexDecodeTable[static_cast<uint8_t>(c)];
 
 } /* hex_char_to_byte() */
 
-}  /* namespace internal */
+
+
+/**
+ * @brief Decode table of the tolerant decoder: nibble values, g_u8HexSeparatorChar for the characters
+ *        skipped between bytes (whitespace and : , ; - . _ |), g_u8InvalidHexChar otherwise.
+ */
+constexpr std::array<uint8_t, 256> g_au8HexTolerantTable = []() {
+    std::array<uint8_t, 256> table = g_au8HexDecodeTable;
+    for (char c : {' ', '\t', '\r', '\n', ':', ',', ';', '-', '.', '_', '|'}) {
+        table[static_cast<uint8_t>(c)] = g_u8HexSeparatorChar;
+    }
+    return table;
+}();
 
 
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Converts a buffer of bytes to a hexadecimal string.
- * @param InBuffer The input buffer of bytes.
- * @param szOffset The offset in the input buffer to start conversion.
- * @param szNrElems The number of elements to convert.
- * @param OutBuffer The output string to store the hexadecimal representation.
- * @return True if the conversion was successful, false otherwise.
+ * @brief Scalar hex encoder, used as fallback and for the tails of the vectorized kernels.
+ * @param pIn Pointer to the input bytes.
+ * @param szLen Number of input bytes.
+ * @param pOut Pointer to the output characters, must have room for 2 * szLen characters.
+ * @tparam bLowercase If true, the letters are written in lowercase.
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-inline bool string_hexlify(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer)
+template<bool bLowercase = false>
+constexpr void hex_encode_scalar(const uint8_t* pIn, size_t szLen, char* pOut) noexcept
 {
-    bool bRetVal = false;
+    const char* pstrDigits = bLowercase ? g_pstrHexDigitsLower : g_pstrHexDigits;
+    for (size_t i = 0; i < szLen; ++i) {
+        uint8_t byte = pIn[i];
+        pOut[2 * i]     = pstrDigits[(byte >> 4) & 0xF];
+        pOut[2 * i + 1] = pstrDigits[byte & 0xF];
+    }
 
-    do {
-        if (szOffset >= InBuffer.size()) {
-            break;
+} /* hex_encode_scalar() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Scalar hex decoder, used as fallback and for the tails of the vectorized kernels.
+ * @param pIn Pointer to the input characters (2 * szLen characters).
+ * @param szLen Number of bytes to decode.
+ * @param pOut Pointer to the output bytes, must have room for szLen bytes.
+ * @return The number of bytes decoded before the first invalid character pair (szLen on success).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t hex_decode_scalar(const char* pIn, size_t szLen, uint8_t* pOut) noexcept
+{
+    for (size_t i = 0; i < szLen; ++i) {
+        uint8_t high = hex_char_to_byte(pIn[2 * i]);
+        uint8_t low  = hex_char_to_byte(pIn[2 * i + 1]);
+        if ((high | low) & 0xF0) {
+            return i;
         }
+        pOut[i] = static_cast<uint8_t>((high << 4) | low);
+    }
 
-        szNrElems = std::min(szNrElems, InBuffer.size() - szOffset);
-        OutBuffer.clear();
-        OutBuffer.reserve(szNrElems * 2);
+    return szLen;
+
+} /* hex_decode_scalar() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Reverses the byte order of a single unsigned integer.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename U>
+constexpr U byteswap_value(U value) noexcept
+{
+    static_assert(std::is_unsigned<U>::value, "U must be an unsigned integer");
+
+#if defined(__GNUC__)
+    if constexpr (sizeof(U) == 2) return __builtin_bswap16(value);
+    if constexpr (sizeof(U) == 4) return __builtin_bswap32(value);
+    if constexpr (sizeof(U) == 8) return __builtin_bswap64(value);
+#endif
+    U result = 0;
+    for (size_t i = 0; i < sizeof(U); ++i, value >>= 8) {
+        result = static_cast<U>((result << 8) | (value & 0xFF));
+    }
+    return result;
 
-        for (size_t i = 0; i < szNrElems; ++i) {
-            uint8_t byte = InBuffer[szOffset + i];
-            OutBuffer.push_back(internal::g_pstrHexDigits[(byte >> 4) & 0xF]);
-            OutBuffer.push_back(internal::g_pstrHexDigits[byte & 0xF]);
+} /* byteswap_value() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Reverses in place the byte order of szCount consecutive N-byte elements.
+ * @tparam N The element size in bytes.
+ * @param pData Pointer to the first element (no alignment required).
+ * @param szCount Number of elements.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<size_t N>
+inline void byteswap_scalar(uint8_t* pData, size_t szCount) noexcept
+{
+    using Word = std::conditional_t<N == 2, uint16_t, std::conditional_t<N == 4, uint32_t, uint64_t>>;
+
+    for (size_t i = 0; i < szCount; ++i, pData += N) {
+        if constexpr (N == 2 || N == 4 || N == 8) {
+            Word value;
+            std::memcpy(&value, pData, N);
+            value = byteswap_value(value);
+            std::memcpy(pData, &value, N);
+        } else {
+            std::reverse(pData, pData + N);
         }
+    }
 
-        bRetVal = true;
-    } while (false);
+} /* byteswap_scalar() */
 
-    return bRetVal;
 
-} /* string_hexlify() */
+#if defined(uHEXLIFY_SIMD_X86)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Maps 16 nibbles (0..15) to their hexadecimal characters, uppercase unless bLowercase.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<bool bLowercase = false>
+__attribute__((target("sse2")))
+inline __m128i hex_nibbles_to_ascii_sse2(__m128i nibbles)
+{
+    constexpr char cLetterOffset = (bLowercase ? 'a' : 'A') - '0' - 10;
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8(cLetterOffset));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+
+} /* hex_nibbles_to_ascii_sse2() */
 
 
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Converts a hexadecimal string to a buffer of bytes.
- * @param hex The input hexadecimal string.
- * @param result The output buffer to store the bytes.
- * @return True if the conversion was successful, false otherwise.
+ * @brief Maps 16 hexadecimal characters to their nibble values and flags the valid ones.
+ * @param chars The input characters.
+ * @param valid Set to 0xFF in every lane holding a valid hexadecimal character, 0x00 otherwise.
+ * @return The nibble values (undefined in the invalid lanes).
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-inline bool string_unhexlify(const std::string& hex, std::vector<uint8_t>& result)
+__attribute__((target("sse2")))
+inline __m128i hex_ascii_to_nibbles_sse2(__m128i chars, __m128i& valid)
 {
-    bool bRetVal = false;
+    const __m128i lower   = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    const __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    const __m128i digits  = _mm_and_si128(isDigit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+    const __m128i alphas  = _mm_and_si128(isAlpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
 
-    do {
-        if (hex.size() % 2 != 0) {
-            break;
-        }
+    valid = _mm_or_si128(isDigit, isAlpha);
+    return _mm_or_si128(digits, alphas);
 
-        result.clear();
-        result.reserve(hex.size() / 2);
+} /* hex_ascii_to_nibbles_sse2() */
 
-        try {
-            for (size_t i = 0; i < hex.size(); i += 2) {
-                uint8_t high = internal::hex_char_to_byte(hex[i]);
-                uint8_t low  = internal::hex_char_to_byte(hex[i + 1]);
-                result.push_back((high << 4) | low);
-            }
-            bRetVal = true;
-        } catch (const std::invalid_argument&) {
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief SSE2 hex encoder, 16 input bytes per iteration.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<bool bLowercase = false>
+__attribute__((target("sse2")))
+inline void hex_encode_sse2(const uint8_t* pIn, size_t szLen, char* pOut)
+{
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= szLen; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+        const __m128i high  = hex_nibbles_to_ascii_sse2<bLowercase>(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+        const __m128i low   = hex_nibbles_to_ascii_sse2<bLowercase>(_mm_and_si128(bytes, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + 2 * i),      _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+
+    hex_encode_scalar<bLowercase>(pIn + i, szLen - i, pOut + 2 * i);
+
+} /* hex_encode_sse2() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief SSE2 hex decoder, 32 input characters per iteration.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("sse2")))
+inline size_t hex_decode_sse2(const char* pIn, size_t szLen, uint8_t* pOut)
+{
+    const __m128i lowByte = _mm_set1_epi16(0x00FF);
+    size_t i = 0;
+
+    for (; i + 16 <= szLen; i += 16) {
+        __m128i valid0, valid1;
+        const __m128i nibbles0 = hex_ascii_to_nibbles_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + 2 * i)), valid0);
+        const __m128i nibbles1 = hex_ascii_to_nibbles_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + 2 * i + 16)), valid1);
+
+        if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xFFFF) {
             break;
         }
 
-    } while (false);
+        /* first character of each pair sits in the low byte of the 16-bit lane */
+        const __m128i bytes0 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles0, lowByte), 4), _mm_srli_epi16(nibbles0, 8));
+        const __m128i bytes1 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles1, lowByte), 4), _mm_srli_epi16(nibbles1, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_packus_epi16(bytes0, bytes1));
+    }
 
-    return bRetVal;
+    return i + hex_decode_scalar(pIn + 2 * i, szLen - i, pOut + i);
 
-} /* string_unhexlify() */
+} /* hex_decode_sse2() */
 
 
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Converts a buffer of any trivially copyable type to a hexadecimal string.
- * @tparam T The type of elements in the input buffer.
- * @param data The input buffer of elements.
- * @param out The output string to store the hexadecimal representation.
- * @param endian The endianness to use for the conversion.
- * @return True if the conversion was successful, false otherwise.
+ * @brief AVX2 counterpart of hex_nibbles_to_ascii_sse2().
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-template<typename T>
-bool string_hexlify_any(const std::vector<T>& data, std::string& out, Endianness endian = Endianness::Little)
+template<bool bLowercase = false>
+__attribute__((target("avx2")))
+inline __m256i hex_nibbles_to_ascii_avx2(__m256i nibbles)
 {
-    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    constexpr char cLetterOffset = (bLowercase ? 'a' : 'A') - '0' - 10;
+    const __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9)), _mm256_set1_epi8(cLetterOffset));
+    return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), letters);
 
-    const uint8_t* bytePtr = reinterpret_cast<const uint8_t*>(data.data());
-    size_t byteCount = data.size() * sizeof(T);
-    out.clear();
-    out.reserve(byteCount * 2 + 2);
-
-    // Add endianness marker
-    uint8_t marker = (endian == Endianness::Little) ? 0x4C : 0x42; // 'L' or 'B'
-    out.push_back(internal::g_pstrHexDigits[(marker >> 4) & 0xF]);
-    out.push_back(internal::g_pstrHexDigits[marker & 0xF]);
-
-    bool systemIsLE = internal::is_system_little_endian();
-
-    if ((endian == Endianness::Big && systemIsLE) || (endian == Endianness::Little && !systemIsLE)) {
-        // Reverse byte order of each element
-        size_t elemSize = sizeof(T);
-        for (size_t i = 0; i < data.size(); ++i) {
-            const uint8_t* elemPtr = reinterpret_cast<const uint8_t*>(&data[i]);
-            for (size_t j = 0; j < elemSize; ++j) {
-                uint8_t byte = elemPtr[elemSize - 1 - j];
-                out.push_back(internal::g_pstrHexDigits[(byte >> 4) & 0xF]);
-                out.push_back(internal::g_pstrHexDigits[byte & 0xF]);
-            }
-        }
-    } else {
-        // Native byte order
-        for (size_t i = 0; i < byteCount; ++i) {
-            uint8_t byte = bytePtr[i];
-            out.push_back(internal::g_pstrHexDigits[(byte >> 4) & 0xF]);
-            out.push_back(internal::g_pstrHexDigits[byte & 0xF]);
-        }
+} /* hex_nibbles_to_ascii_avx2() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief AVX2 counterpart of hex_ascii_to_nibbles_sse2().
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+inline __m256i hex_ascii_to_nibbles_avx2(__m256i chars, __m256i& valid)
+{
+    const __m256i lower   = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+    const __m256i isDigit = _mm256_andnot_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('9')), _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)));
+    const __m256i isAlpha = _mm256_andnot_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('f')), _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)));
+    const __m256i digits  = _mm256_and_si256(isDigit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0')));
+    const __m256i alphas  = _mm256_and_si256(isAlpha, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)));
+
+    valid = _mm256_or_si256(isDigit, isAlpha);
+    return _mm256_or_si256(digits, alphas);
+
+} /* hex_ascii_to_nibbles_avx2() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief AVX2 hex encoder, 32 input bytes per iteration.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<bool bLowercase = false>
+__attribute__((target("avx2")))
+inline void hex_encode_avx2(const uint8_t* pIn, size_t szLen, char* pOut)
+{
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 32 <= szLen; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + i));
+        const __m256i high  = hex_nibbles_to_ascii_avx2<bLowercase>(_mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+        const __m256i low   = hex_nibbles_to_ascii_avx2<bLowercase>(_mm256_and_si256(bytes, mask));
+
+        /* unpack works per 128-bit lane, so the halves have to be put back in order */
+        const __m256i first  = _mm256_unpacklo_epi8(high, low);
+        const __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + 2 * i),      _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
     }
 
-    return true;
+    hex_encode_sse2<bLowercase>(pIn + i, szLen - i, pOut + 2 * i);
 
-} /* string_hexlify_any() */
+} /* hex_encode_avx2() */
 
 
 
 /*--------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Converts a hexadecimal string to a buffer of any trivially copyable type.
- * @tparam T The type of elements in the output buffer.
- * @param hex The input hexadecimal string.
- * @param result The output buffer to store the elements.
- * @return True if the conversion was successful, false otherwise.
+ * @brief AVX2 hex decoder, 64 input characters per iteration.
  */
 /*--------------------------------------------------------------------------------------------------------*/
 
-template<typename T>
-bool string_unhexlify_any(const std::string& hex, std::vector<T>& result)
+__attribute__((target("avx2")))
+inline size_t hex_decode_avx2(const char* pIn, size_t szLen, uint8_t* pOut)
 {
-    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    const __m256i lowByte = _mm256_set1_epi16(0x00FF);
+    size_t i = 0;
 
-    bool bRetVal = false;
+    for (; i + 32 <= szLen; i += 32) {
+        __m256i valid0, valid1;
+        const __m256i nibbles0 = hex_ascii_to_nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + 2 * i)), valid0);
+        const __m256i nibbles1 = hex_ascii_to_nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn + 2 * i + 32)), valid1);
 
-    do {
-        if (hex.size() < 2 || hex.size() % 2 != 0) {
+        if (_mm256_movemask_epi8(_mm256_and_si256(valid0, valid1)) != -1) {
             break;
         }
 
-        uint8_t marker = (internal::hex_char_to_byte(hex[0]) << 4) | internal::hex_char_to_byte(hex[1]);
-        Endianness targetEndian;
-        if (marker == 0x4C) targetEndian = Endianness::Little;
-        else if (marker == 0x42) targetEndian = Endianness::Big;
-        else break;
+        const __m256i bytes0 = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(nibbles0, lowByte), 4), _mm256_srli_epi16(nibbles0, 8));
+        const __m256i bytes1 = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(nibbles1, lowByte), 4), _mm256_srli_epi16(nibbles1, 8));
 
-        size_t byteCount = (hex.size() - 2) / 2;
-        if (byteCount % sizeof(T) != 0) {
-            break;
-        }
+        /* packus interleaves the 64-bit quarters of both operands, restore the byte order */
+        const __m256i packed = _mm256_packus_epi16(bytes0, bytes1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
 
-        std::vector<uint8_t> bytes;
-        bytes.reserve(byteCount);
-        try {
-            for (size_t i = 0; i < byteCount; ++i) {
-                uint8_t high = internal::hex_char_to_byte(hex[2 + 2 * i]);
-                uint8_t low  = internal::hex_char_to_byte(hex[2 + 2 * i + 1]);
-                bytes.push_back((high << 4) | low);
-            }
-        } catch (const std::invalid_argument&) {
-            break;
-        }
+    return i + hex_decode_sse2(pIn + 2 * i, szLen - i, pOut + i);
 
-        bool systemIsLE = internal::is_system_little_endian();
-        if ((targetEndian == Endianness::Little && !systemIsLE) ||
-                (targetEndian == Endianness::Big && systemIsLE)) {
-            size_t elemSize = sizeof(T);
-            for (size_t i = 0; i < byteCount; i += elemSize) {
-                std::reverse(bytes.begin() + i, bytes.begin() + i + elemSize);
-            }
+} /* hex_decode_avx2() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief AVX2 in-place byte swap of N-byte elements (N = 2, 4, 8), 32 bytes per iteration.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<size_t N>
+__attribute__((target("avx2")))
+inline void byteswap_avx2(uint8_t* pData, size_t szCount)
+{
+    static_assert(16 % N == 0, "element size must divide the 128-bit lane");
+
+    /* pshufb reverses every N-byte group within each 128-bit lane */
+    static constexpr std::array<uint8_t, 32> s_au8Mask = []() {
+        std::array<uint8_t, 32> mask{};
+        for (size_t i = 0; i < mask.size(); ++i) {
+            size_t lanePos = i % 16;
+            mask[i] = static_cast<uint8_t>((lanePos / N) * N + (N - 1 - lanePos % N));
         }
+        return mask;
+    }();
 
-        result.clear();
-        result.resize(byteCount / sizeof(T));
-        std::memcpy(result.data(), bytes.data(), byteCount);
-        bRetVal = true;
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s_au8Mask.data()));
+    const size_t szBytes = szCount * N;
+    size_t i = 0;
 
-    } while (false);
+    for (; i + 32 <= szBytes; i += 32) {
+        __m256i* pBlock = reinterpret_cast<__m256i*>(pData + i);
+        _mm256_storeu_si256(pBlock, _mm256_shuffle_epi8(_mm256_loadu_si256(pBlock), mask));
+    }
 
-    return bRetVal;
+    byteswap_scalar<N>(pData + i, (szBytes - i) / N);
 
-} /* string_unhexlify_any() */
+} /* byteswap_avx2() */
+
+#elif defined(uHEXLIFY_SIMD_NEON)
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief NEON hex encoder, 16 input bytes per iteration.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<bool bLowercase = false>
+inline void hex_encode_neon(const uint8_t* pIn, size_t szLen, char* pOut)
+{
+    const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t*>(bLowercase ? g_pstrHexDigitsLower : g_pstrHexDigits));
+    const uint8x16_t mask   = vdupq_n_u8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= szLen; i += 16) {
+        const uint8x16_t bytes = vld1q_u8(pIn + i);
+        uint8x16x2_t chars;
+        chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+        chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, mask));
+        vst2q_u8(reinterpret_cast<uint8_t*>(pOut + 2 * i), chars);
+    }
+
+    hex_encode_scalar<bLowercase>(pIn + i, szLen - i, pOut + 2 * i);
+
+} /* hex_encode_neon() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Maps 16 hexadecimal characters to their nibble values and flags the valid ones.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline uint8x16_t hex_ascii_to_nibbles_neon(uint8x16_t chars, uint8x16_t& valid)
+{
+    const uint8x16_t digits  = vsubq_u8(chars, vdupq_n_u8('0'));
+    const uint8x16_t alphas  = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t isDigit = vcltq_u8(digits, vdupq_n_u8(10));
+    const uint8x16_t isAlpha = vcltq_u8(alphas, vdupq_n_u8(6));
+
+    valid = vorrq_u8(isDigit, isAlpha);
+    return vbslq_u8(isDigit, digits, vaddq_u8(alphas, vdupq_n_u8(10)));
+
+} /* hex_ascii_to_nibbles_neon() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief NEON hex decoder, 32 input characters per iteration.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t hex_decode_neon(const char* pIn, size_t szLen, uint8_t* pOut)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= szLen; i += 16) {
+        const uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t*>(pIn + 2 * i));
+        uint8x16_t validHigh, validLow;
+        const uint8x16_t high = hex_ascii_to_nibbles_neon(chars.val[0], validHigh);
+        const uint8x16_t low  = hex_ascii_to_nibbles_neon(chars.val[1], validLow);
+
+        if (vminvq_u8(vandq_u8(validHigh, validLow)) != 0xFF) {
+            break;
+        }
+
+        vst1q_u8(pOut + i, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+
+    return i + hex_decode_scalar(pIn + 2 * i, szLen - i, pOut + i);
+
+} /* hex_decode_neon() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief NEON in-place byte swap of N-byte elements (N = 2, 4, 8), 16 bytes per iteration.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<size_t N>
+inline void byteswap_neon(uint8_t* pData, size_t szCount)
+{
+    const size_t szBytes = szCount * N;
+    size_t i = 0;
+
+    for (; i + 16 <= szBytes; i += 16) {
+        const uint8x16_t block = vld1q_u8(pData + i);
+        if constexpr (N == 2) vst1q_u8(pData + i, vrev16q_u8(block));
+        if constexpr (N == 4) vst1q_u8(pData + i, vrev32q_u8(block));
+        if constexpr (N == 8) vst1q_u8(pData + i, vrev64q_u8(block));
+    }
+
+    byteswap_scalar<N>(pData + i, (szBytes - i) / N);
+
+} /* byteswap_neon() */
+
+#endif /* uHEXLIFY_SIMD_X86 / uHEXLIFY_SIMD_NEON */
+
+
+
+/**
+ * @brief Encoder kernel signature: writes 2 * szLen characters to pOut.
+ */
+using HexEncodeFn = void (*)(const uint8_t* pIn, size_t szLen, char* pOut);
+
+/**
+ * @brief Decoder kernel signature: decodes szLen bytes, returns the number of bytes decoded before the first invalid pair.
+ */
+using HexDecodeFn = size_t (*)(const char* pIn, size_t szLen, uint8_t* pOut);
+
+/**
+ * @brief In-place byte swap kernel signature: reverses the byte order of szCount consecutive elements.
+ */
+using ByteSwapFn = void (*)(uint8_t* pData, size_t szCount);
+
+/**
+ * @brief The encode (uppercase and lowercase), decode and byte swap kernels selected for the running CPU.
+ */
+struct HexKernels
+{
+    HexEncodeFn pfnEncode;
+    HexEncodeFn pfnEncodeLower;
+    HexDecodeFn pfnDecode;
+    ByteSwapFn  pfnSwap16;
+    ByteSwapFn  pfnSwap32;
+    ByteSwapFn  pfnSwap64;
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Selects the best kernels supported by the running CPU (evaluated once).
+ * @return Reference to the selected kernels.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline const HexKernels& hex_kernels()
+{
+    static const HexKernels kernels = []() -> HexKernels {
+#if defined(uHEXLIFY_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return { hex_encode_avx2<false>, hex_encode_avx2<true>, hex_decode_avx2, byteswap_avx2<2>, byteswap_avx2<4>, byteswap_avx2<8> };
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return { hex_encode_sse2<false>, hex_encode_sse2<true>, hex_decode_sse2, byteswap_scalar<2>, byteswap_scalar<4>, byteswap_scalar<8> };
+        }
+#elif defined(uHEXLIFY_SIMD_NEON)
+        return { hex_encode_neon<false>, hex_encode_neon<true>, hex_decode_neon, byteswap_neon<2>, byteswap_neon<4>, byteswap_neon<8> };
+#endif
+        return { hex_encode_scalar<false>, hex_encode_scalar<true>, hex_decode_scalar, byteswap_scalar<2>, byteswap_scalar<4>, byteswap_scalar<8> };
+    }();
+
+    return kernels;
+
+} /* hex_kernels() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Reverses in place the byte order of szCount consecutive N-byte elements,
+ *        using the vectorized kernel when one exists for the element size.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<size_t N>
+inline void byteswap_elements(uint8_t* pData, size_t szCount)
+{
+    if constexpr (N == 2) {
+        hex_kernels().pfnSwap16(pData, szCount);
+    } else if constexpr (N == 4) {
+        hex_kernels().pfnSwap32(pData, szCount);
+    } else if constexpr (N == 8) {
+        hex_kernels().pfnSwap64(pData, szCount);
+    } else if constexpr (N > 1) {
+        byteswap_scalar<N>(pData, szCount);
+    }
+
+} /* byteswap_elements() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Decodes a hexadecimal string of even length into a caller-provided buffer.
+ * @param pIn Pointer to the input hexadecimal characters, 2 * szLen characters.
+ * @param szLen Number of bytes to decode.
+ * @param pOut Pointer to the output bytes, must have room for szLen bytes.
+ * @param szBaseOffset Offset of pIn within the caller's input, added to the reported error offset.
+ * @return The outcome of the conversion, with the offset of the first invalid character on error.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline HexResult hex_decode(const char* pIn, size_t szLen, uint8_t* pOut, size_t szBaseOffset = 0) noexcept
+{
+    HexResult result;
+
+    result.szWritten = hex_kernels().pfnDecode(pIn, szLen, pOut);
+    if (result.szWritten != szLen) {
+        size_t szPairOffset = 2 * result.szWritten;
+        result.eStatus = HexStatus::InvalidChar;
+        result.szErrorOffset = szBaseOffset + szPairOffset + ((g_u8InvalidHexChar == hex_char_to_byte(pIn[szPairOffset])) ? 0 : 1);
+    }
+
+    return result;
+
+} /* hex_decode() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Encodes elements as hex in the target byte order (no marker).
+ *
+ * The byte order decision is made at compile time. During constant evaluation the elements are
+ * converted one by one through std::bit_cast, at run time the vectorized kernels are used.
+ *
+ * @tparam E The target endianness.
+ * @tparam T The element type.
+ * @param pData Pointer to the input elements.
+ * @param szCount Number of elements.
+ * @param pOut Pointer to the output characters, must have room for 2 * szCount * sizeof(T) characters.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<Endianness E, typename T>
+constexpr void hexlify_elements(const T* pData, size_t szCount, char* pOut) noexcept
+{
+    if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < szCount; ++i) {
+            auto bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(pData[i]);
+            if constexpr (needs_byteswap<E, T>()) {
+                std::reverse(bytes.begin(), bytes.end());
+            }
+            hex_encode_scalar(bytes.data(), sizeof(T), pOut + 2 * i * sizeof(T));
+        }
+    } else if constexpr (needs_byteswap<E, T>()) {
+        /* swap a cache-sized block on the stack, then encode it while it is still hot */
+        constexpr size_t szBlockElems = std::max<size_t>(g_szSwapBlockSize / sizeof(T), 1);
+        alignas(32) uint8_t block[szBlockElems * sizeof(T)];
+        const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pData);
+        for (size_t i = 0; i < szCount; i += szBlockElems) {
+            size_t szBlockBytes = std::min(szBlockElems, szCount - i) * sizeof(T);
+            std::memcpy(block, pBytes + i * sizeof(T), szBlockBytes);
+            byteswap_elements<sizeof(T)>(block, szBlockBytes / sizeof(T));
+            hex_kernels().pfnEncode(block, szBlockBytes, pOut + 2 * i * sizeof(T));
+        }
+    } else {
+        hex_kernels().pfnEncode(reinterpret_cast<const uint8_t*>(pData), szCount * sizeof(T), pOut);
+    }
+
+} /* hexlify_elements() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Decodes hex stored in the source byte order into elements (no marker).
+ *
+ * Counterpart of hexlify_elements(): compile-time byte order decision, std::bit_cast during constant
+ * evaluation, in-place decoding and cache-blocked swapping at run time.
+ *
+ * @tparam E The endianness of the hex input.
+ * @tparam T The element type.
+ * @param pIn Pointer to the input characters, 2 * szCount * sizeof(T) characters.
+ * @param szCount Number of elements.
+ * @param pOut Pointer to the output elements.
+ * @param szBaseOffset Offset of pIn within the caller's input, added to the reported error offset.
+ * @return The outcome of the conversion; szWritten counts bytes.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<Endianness E, typename T>
+constexpr HexResult unhexlify_elements(const char* pIn, size_t szCount, T* pOut, size_t szBaseOffset = 0) noexcept
+{
+    HexResult result;
+
+    if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < szCount; ++i) {
+            std::array<uint8_t, sizeof(T)> bytes{};
+            const char* pElem = pIn + 2 * i * sizeof(T);
+            size_t szDecoded = hex_decode_scalar(pElem, sizeof(T), bytes.data());
+            result.szWritten += szDecoded;
+            if (szDecoded != sizeof(T)) {
+                result.eStatus = HexStatus::InvalidChar;
+                result.szErrorOffset = szBaseOffset + 2 * (i * sizeof(T) + szDecoded) +
+                                       ((g_u8InvalidHexChar == hex_char_to_byte(pElem[2 * szDecoded])) ? 0 : 1);
+                break;
+            }
+            if constexpr (needs_byteswap<E, T>()) {
+                std::reverse(bytes.begin(), bytes.end());
+            }
+            pOut[i] = std::bit_cast<T>(bytes);
+        }
+    } else if constexpr (needs_byteswap<E, T>()) {
+        /* decode a cache-sized block in place, then swap it while it is still hot */
+        constexpr size_t szBlockBytes = std::max<size_t>(g_szSwapBlockSize / sizeof(T), 1) * sizeof(T);
+        const size_t szBytes = szCount * sizeof(T);
+        uint8_t* pBytes = reinterpret_cast<uint8_t*>(pOut);
+        for (size_t i = 0; i < szBytes; i += szBlockBytes) {
+            size_t szLen = std::min(szBlockBytes, szBytes - i);
+            HexResult block = hex_decode(pIn + 2 * i, szLen, pBytes + i, szBaseOffset + 2 * i);
+            result.szWritten += block.szWritten;
+            if (!block) {
+                result.eStatus = block.eStatus;
+                result.szErrorOffset = block.szErrorOffset;
+                break;
+            }
+            byteswap_elements<sizeof(T)>(pBytes + i, szLen / sizeof(T));
+        }
+    } else {
+        result = hex_decode(pIn, szCount * sizeof(T), reinterpret_cast<uint8_t*>(pOut), szBaseOffset);
+    }
+
+    return result;
+
+} /* unhexlify_elements() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Reads up to szLen bytes from a file descriptor, retrying on interruption.
+ * @return The number of bytes read, 0 at end of file, negative on error.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline long fd_read(int iFd, void* pBuffer, size_t szLen)
+{
+#ifdef _WIN32
+    return ::_read(iFd, pBuffer, static_cast<unsigned int>(szLen));
+#else
+    ssize_t result;
+    do {
+        result = ::read(iFd, pBuffer, szLen);
+    } while (result < 0 && errno == EINTR);
+    return static_cast<long>(result);
+#endif
+
+} /* fd_read() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Writes szLen bytes to a file descriptor, handling short writes and interruptions.
+ * @return True if all the bytes were written, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool fd_write_all(int iFd, const void* pBuffer, size_t szLen)
+{
+    const char* pData = static_cast<const char*>(pBuffer);
+
+    while (szLen > 0) {
+#ifdef _WIN32
+        int result = ::_write(iFd, pData, static_cast<unsigned int>(szLen));
+#else
+        ssize_t result = ::write(iFd, pData, szLen);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (result <= 0) {
+            return false;
+        }
+        pData += result;
+        szLen -= static_cast<size_t>(result);
+    }
+
+    return true;
+
+} /* fd_write_all() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Runs a task over consecutive chunks of a range on several threads.
+ *
+ * The workers (the calling thread included) pick the next chunk from a shared atomic counter, so uneven
+ * chunks balance out. If a thread cannot be started, the already running ones finish the work.
+ *
+ * @param szTotal The size of the range.
+ * @param szChunkSize The size of a chunk, the last one may be shorter.
+ * @param uThreads The maximum number of threads, calling thread included.
+ * @param fnTask Called as fnTask(szBegin, szLen) for every chunk.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename Task>
+inline void parallel_chunks(size_t szTotal, size_t szChunkSize, unsigned uThreads, const Task& fnTask)
+{
+    const size_t szChunks = (szTotal + szChunkSize - 1) / szChunkSize;
+    std::atomic<size_t> szNextChunk{0};
+
+    auto worker = [&]() {
+        for (size_t szChunk = szNextChunk.fetch_add(1, std::memory_order_relaxed); szChunk < szChunks;
+             szChunk = szNextChunk.fetch_add(1, std::memory_order_relaxed)) {
+            size_t szBegin = szChunk * szChunkSize;
+            fnTask(szBegin, std::min(szChunkSize, szTotal - szBegin));
+        }
+    };
+
+    std::vector<std::thread> vThreads;
+    size_t szHelpers = std::min<size_t>(uThreads, szChunks);
+    if (szHelpers > 0) {
+        --szHelpers;
+    }
+    vThreads.reserve(szHelpers);
+
+    for (size_t i = 0; i < szHelpers; ++i) {
+        try {
+            vThreads.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+
+    worker();
+
+    for (std::thread& thread : vThreads) {
+        thread.join();
+    }
+
+} /* parallel_chunks() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Copies a string to pOut (empty strings included) and returns the position after it.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline char* hex_append(char* pOut, std::string_view str) noexcept
+{
+    if (!str.empty()) {
+        std::memcpy(pOut, str.data(), str.size());
+    }
+    return pOut + str.size();
+
+} /* hex_append() */
+
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Writes bytes as [prefix]XX joined by the separators of a HexFormat.
+ *
+ * For large inputs with short cells, the text of every byte preceded by its separator is prebuilt for
+ * the 256 byte values, and each byte is then emitted with one fixed-size copy (the overlapping tail is
+ * overwritten by the next cell).
+ *
+ * @param pIn Pointer to the input bytes.
+ * @param szLen Number of input bytes.
+ * @param pOut Pointer to the output characters.
+ * @param pEnd End of the output, exactly hexlified_size(szLen, format) characters after pOut.
+ * @param format The layout of the output.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline void hex_format_bytes(const uint8_t* pIn, size_t szLen, char* pOut, char* pEnd, const HexFormat& format) noexcept
+{
+    const char* pstrDigits = format.bLowercase ? g_pstrHexDigitsLower : g_pstrHexDigits;
+    const std::string_view strPrefix = format.strBytePrefix;
+    const std::string_view strSeparator = format.strSeparator;
+    const size_t szGroupSize = (0 != format.szGroupSize) ? format.szGroupSize : szLen;
+    const size_t szCell = strSeparator.size() + strPrefix.size() + 2;
+
+    /* first byte of a group: group separator (if any), prefix, digits */
+    auto write_group_start = [&](size_t i) {
+        if (i > 0) {
+            pOut = hex_append(pOut, format.strGroupSeparator);
+        }
+        pOut = hex_append(pOut, strPrefix);
+        pOut[0] = pstrDigits[pIn[i] >> 4];
+        pOut[1] = pstrDigits[pIn[i] & 0xF];
+        pOut += 2;
+    };
+
+    if ((szCell > g_szHexCellSize) || (szLen < g_szHexCellTableMin)) {
+        for (size_t i = 0; i < szLen; ++i) {
+            if (i % szGroupSize == 0) {
+                write_group_start(i);
+                continue;
+            }
+            pOut = hex_append(pOut, strSeparator);
+            pOut = hex_append(pOut, strPrefix);
+            pOut[0] = pstrDigits[pIn[i] >> 4];
+            pOut[1] = pstrDigits[pIn[i] & 0xF];
+            pOut += 2;
+        }
+        return;
+    }
+
+    char acCells[256][g_szHexCellSize];
+    for (size_t b = 0; b < 256; ++b) {
+        char* pCell = acCells[b];
+        hex_append(hex_append(pCell, strSeparator), strPrefix);
+        pCell[szCell - 2] = pstrDigits[b >> 4];
+        pCell[szCell - 1] = pstrDigits[b & 0xF];
+    }
+
+    size_t szInGroup = 0;
+    for (size_t i = 0; i < szLen; ++i) {
+        if (0 == szInGroup) {
+            write_group_start(i);
+        } else if (pOut + g_szHexCellSize <= pEnd) {
+            std::memcpy(pOut, acCells[pIn[i]], g_szHexCellSize);
+            pOut += szCell;
+        } else {
+            std::memcpy(pOut, acCells[pIn[i]], szCell);
+            pOut += szCell;
+        }
+        if (++szInGroup == szGroupSize) {
+            szInGroup = 0;
+        }
+    }
+
+} /* hex_format_bytes() */
+
+}  /* namespace internal */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the number of characters needed to hexlify a number of bytes.
+ * @param szBytes The number of input bytes.
+ * @return The number of hexadecimal characters.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t hexlified_size(size_t szBytes) noexcept
+{
+    return szBytes * 2;
+
+} /* hexlified_size() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the number of characters needed by string_hexlify_any() for a number of elements,
+ *        including the endianness marker.
+ * @tparam T The type of the elements.
+ * @param szNrElems The number of input elements.
+ * @return The number of hexadecimal characters.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename T>
+constexpr size_t hexlified_size_any(size_t szNrElems) noexcept
+{
+    return hexlified_size(1 + szNrElems * sizeof(T));
+
+} /* hexlified_size_any() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the number of bytes obtained by unhexlifying a number of characters.
+ * @param szChars The number of hexadecimal characters.
+ * @return The number of bytes.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t unhexlified_size(size_t szChars) noexcept
+{
+    return szChars / 2;
+
+} /* unhexlified_size() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Returns the number of characters needed to hexlify a number of bytes with a given layout.
+ * @param szBytes The number of input bytes.
+ * @param format The layout of the output.
+ * @return The number of characters, prefixes and separators included.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t hexlified_size(size_t szBytes, const HexFormat& format) noexcept
+{
+    if (0 == szBytes) {
+        return 0;
+    }
+
+    size_t szGroupBoundaries = (0 != format.szGroupSize) ? (szBytes - 1) / format.szGroupSize : 0;
+    size_t szByteBoundaries  = (szBytes - 1) - szGroupBoundaries;
+
+    return szBytes * (2 + format.strBytePrefix.size()) + szByteBoundaries * format.strSeparator.size() +
+           szGroupBoundaries * format.strGroupSeparator.size();
+
+} /* hexlified_size() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a buffer of bytes to a hexadecimal string.
+ * @param InBuffer The input buffer of bytes.
+ * @param szOffset The offset in the input buffer to start conversion.
+ * @param szNrElems The number of elements to convert.
+ * @param OutBuffer The output string to store the hexadecimal representation.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool string_hexlify(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer)
+{
+    bool bRetVal = false;
+
+    do {
+        if (szOffset >= InBuffer.size()) {
+            break;
+        }
+
+        szNrElems = std::min(szNrElems, InBuffer.size() - szOffset);
+        OutBuffer.resize(hexlified_size(szNrElems));
+        internal::hex_kernels().pfnEncode(InBuffer.data() + szOffset, szNrElems, OutBuffer.data());
+
+        bRetVal = true;
+    } while (false);
+
+    return bRetVal;
+
+} /* string_hexlify() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a buffer of bytes to hexadecimal characters stored in a caller-provided buffer.
+ * @param in The input bytes.
+ * @param out The output buffer, must hold at least hexlified_size(in.size()) characters.
+ * @return The number of characters written, 0 if the output buffer is too small.
+ *
+ * @note No allocation is performed; the output is not null-terminated.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t string_hexlify(std::span<const std::byte> in, std::span<char> out) noexcept
+{
+    size_t szWritten = 0;
+
+    do {
+        if (out.size() < hexlified_size(in.size())) {
+            break;
+        }
+
+        internal::hex_kernels().pfnEncode(reinterpret_cast<const uint8_t*>(in.data()), in.size(), out.data());
+        szWritten = hexlified_size(in.size());
+
+    } while (false);
+
+    return szWritten;
+
+} /* string_hexlify() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a buffer of bytes to hexadecimal characters written through an output iterator.
+ * @tparam OutputIt An output iterator accepting char (raw pointers must use the std::span<char> overload).
+ * @param in The input bytes.
+ * @param out The output iterator.
+ * @return The number of characters written.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename OutputIt>
+    requires (std::output_iterator<OutputIt, char> && !std::is_pointer_v<OutputIt>)
+size_t string_hexlify(std::span<const std::byte> in, OutputIt out)
+{
+    char block[hexlified_size(internal::g_szHexBlockSize)];
+    const uint8_t* pIn = reinterpret_cast<const uint8_t*>(in.data());
+
+    for (size_t i = 0; i < in.size(); i += internal::g_szHexBlockSize) {
+        size_t szLen = std::min(internal::g_szHexBlockSize, in.size() - i);
+        internal::hex_kernels().pfnEncode(pIn + i, szLen, block);
+        out = std::copy(block, block + hexlified_size(szLen), out);
+    }
+
+    return hexlified_size(in.size());
+
+} /* string_hexlify() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a buffer of bytes to formatted hexadecimal text (prefixes, separators, groups, case)
+ *        in a single pass over a caller-provided buffer.
+ * @param in The input bytes.
+ * @param out The output buffer, must hold at least hexlified_size(in.size(), format) characters.
+ * @param format The layout of the output.
+ * @return The number of characters written, 0 if the output buffer is too small.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t string_hexlify(std::span<const std::byte> in, std::span<char> out, const HexFormat& format) noexcept
+{
+    size_t szWritten = 0;
+
+    do {
+        const size_t szSize = hexlified_size(in.size(), format);
+        if (out.size() < szSize) {
+            break;
+        }
+
+        const uint8_t* pIn = reinterpret_cast<const uint8_t*>(in.data());
+        char* pOut = out.data();
+        const size_t szGroupSize = (0 != format.szGroupSize) ? format.szGroupSize : in.size();
+
+        if (format.strBytePrefix.empty() && format.strSeparator.empty()) {
+            /* the digits of a group are contiguous: the vector kernel encodes the whole group */
+            const internal::HexKernels& kernels = internal::hex_kernels();
+            const internal::HexEncodeFn pfnEncode = format.bLowercase ? kernels.pfnEncodeLower : kernels.pfnEncode;
+
+            for (size_t i = 0; i < in.size(); i += szGroupSize) {
+                if (i > 0) {
+                    pOut = internal::hex_append(pOut, format.strGroupSeparator);
+                }
+                size_t szLen = std::min(szGroupSize, in.size() - i);
+                pfnEncode(pIn + i, szLen, pOut);
+                pOut += hexlified_size(szLen);
+            }
+        } else {
+            internal::hex_format_bytes(pIn, in.size(), pOut, pOut + szSize, format);
+        }
+
+        szWritten = szSize;
+
+    } while (false);
+
+    return szWritten;
+
+} /* string_hexlify() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a buffer of bytes to a formatted hexadecimal string.
+ * @param InBuffer The input buffer of bytes.
+ * @param szOffset The offset in the input buffer to start conversion.
+ * @param szNrElems The number of elements to convert.
+ * @param OutBuffer The output string to store the hexadecimal representation.
+ * @param format The layout of the output.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool string_hexlify(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer, const HexFormat& format)
+{
+    bool bRetVal = false;
+
+    do {
+        if (szOffset >= InBuffer.size()) {
+            break;
+        }
+
+        szNrElems = std::min(szNrElems, InBuffer.size() - szOffset);
+        OutBuffer.resize(hexlified_size(szNrElems, format));
+        string_hexlify(std::as_bytes(std::span<const uint8_t>(InBuffer.data() + szOffset, szNrElems)), std::span<char>(OutBuffer), format);
+
+        bRetVal = true;
+    } while (false);
+
+    return bRetVal;
+
+} /* string_hexlify() */
+
+
+
+/**
+ * @brief Tuning of the parallel hexlify.
+ */
+struct ParallelOptions {
+    size_t szChunkSize = internal::g_szParallelChunkSize;  /**< Input bytes encoded per task */
+    size_t szThreshold = internal::g_szParallelThreshold;  /**< Inputs smaller than this are encoded on the calling thread */
+    unsigned uThreads  = 0;                                /**< Maximum number of threads, 0 for std::thread::hardware_concurrency() */
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a large buffer of bytes to hexadecimal characters using several threads.
+ *
+ * The input is split in chunks of options.szChunkSize bytes; as every chunk's output starts at twice its
+ * input offset, the chunks are encoded independently, straight into the output buffer.
+ *
+ * @param in The input bytes.
+ * @param out The output buffer, must hold at least hexlified_size(in.size()) characters.
+ * @param options Chunk size, single-thread threshold and thread count.
+ * @return The number of characters written, 0 if the output buffer is too small.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline size_t string_hexlify_parallel(std::span<const std::byte> in, std::span<char> out, const ParallelOptions& options = {})
+{
+    size_t szWritten = 0;
+
+    do {
+        if (out.size() < hexlified_size(in.size())) {
+            break;
+        }
+
+        const uint8_t* pIn = reinterpret_cast<const uint8_t*>(in.data());
+        char* pOut = out.data();
+        const internal::HexEncodeFn pfnEncode = internal::hex_kernels().pfnEncode;
+        unsigned uThreads = (0 != options.uThreads) ? options.uThreads : std::max(std::thread::hardware_concurrency(), 1U);
+
+        if ((in.size() < options.szThreshold) || (uThreads < 2) || (0 == options.szChunkSize)) {
+            pfnEncode(pIn, in.size(), pOut);
+        } else {
+            internal::parallel_chunks(in.size(), options.szChunkSize, uThreads, [&](size_t szBegin, size_t szLen) {
+                pfnEncode(pIn + szBegin, szLen, pOut + hexlified_size(szBegin));
+            });
+        }
+
+        szWritten = hexlified_size(in.size());
+
+    } while (false);
+
+    return szWritten;
+
+} /* string_hexlify_parallel() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a large buffer of bytes to a hexadecimal string using several threads.
+ * @param InBuffer The input buffer of bytes.
+ * @param szOffset The offset in the input buffer to start conversion.
+ * @param szNrElems The number of elements to convert.
+ * @param OutBuffer The output string to store the hexadecimal representation.
+ * @param options Chunk size, single-thread threshold and thread count.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool string_hexlify_parallel(const std::vector<uint8_t>& InBuffer, size_t szOffset, size_t szNrElems, std::string& OutBuffer,
+                                    const ParallelOptions& options = {})
+{
+    bool bRetVal = false;
+
+    do {
+        if (szOffset >= InBuffer.size()) {
+            break;
+        }
+
+        szNrElems = std::min(szNrElems, InBuffer.size() - szOffset);
+        OutBuffer.resize(hexlified_size(szNrElems));
+        string_hexlify_parallel(std::as_bytes(std::span<const uint8_t>(InBuffer.data() + szOffset, szNrElems)),
+                                std::span<char>(OutBuffer), options);
+
+        bRetVal = true;
+    } while (false);
+
+    return bRetVal;
+
+} /* string_hexlify_parallel() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a hexadecimal string to bytes stored in a caller-provided buffer, without throwing.
+ * @param hex The input hexadecimal string.
+ * @param out The output buffer, must hold at least hex.size() / 2 bytes.
+ * @return The outcome of the conversion: the number of bytes written and, on error,
+ *         the status and the offset of the first offending character.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline HexResult string_unhexlify(std::string_view hex, std::span<uint8_t> out) noexcept
+{
+    HexResult result;
+
+    do {
+        if (hex.size() % 2 != 0) {
+            result.eStatus = HexStatus::OddLength;
+            result.szErrorOffset = hex.size() - 1;
+            break;
+        }
+
+        if (out.size() < hex.size() / 2) {
+            result.eStatus = HexStatus::BufferTooSmall;
+            result.szErrorOffset = 2 * out.size();
+            break;
+        }
+
+        result = internal::hex_decode(hex.data(), hex.size() / 2, out.data());
+
+    } while (false);
+
+    return result;
+
+} /* string_unhexlify() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a hexadecimal string to a buffer of bytes.
+ * @param hex The input hexadecimal string.
+ * @param result The output buffer to store the bytes.
+ * @param pszErrorOffset Optional, receives the offset of the first offending character on error.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool string_unhexlify(std::string_view hex, std::vector<uint8_t>& result, size_t* pszErrorOffset = nullptr)
+{
+    bool bRetVal = false;
+
+    do {
+        if (hex.size() % 2 != 0) {
+            if (nullptr != pszErrorOffset) {
+                *pszErrorOffset = hex.size() - 1;
+            }
+            break;
+        }
+
+        result.resize(hex.size() / 2);
+        HexResult decoded = internal::hex_decode(hex.data(), result.size(), result.data());
+
+        /* on error keep the bytes decoded before the first invalid character */
+        result.resize(decoded.szWritten);
+        if (!decoded && (nullptr != pszErrorOffset)) {
+            *pszErrorOffset = decoded.szErrorOffset;
+        }
+        bRetVal = static_cast<bool>(decoded);
+
+    } while (false);
+
+    return bRetVal;
+
+} /* string_unhexlify() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a hexadecimal string to bytes stored in a caller-provided std::byte buffer, without throwing.
+ * @param hex The input hexadecimal string.
+ * @param out The output buffer, must hold at least unhexlified_size(hex.size()) bytes.
+ * @return The outcome of the conversion, see string_unhexlify(std::string_view, std::span<uint8_t>).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline HexResult string_unhexlify(std::string_view hex, std::span<std::byte> out) noexcept
+{
+    return string_unhexlify(hex, std::span<uint8_t>(reinterpret_cast<uint8_t*>(out.data()), out.size()));
+
+} /* string_unhexlify() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a hexadecimal string to bytes written through an output iterator, without throwing.
+ * @tparam OutputIt An output iterator accepting uint8_t (raw pointers must use the std::span overloads).
+ * @param hex The input hexadecimal string.
+ * @param out The output iterator; on error the bytes preceding the first invalid character are written.
+ * @return The outcome of the conversion, see string_unhexlify(std::string_view, std::span<uint8_t>).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename OutputIt>
+    requires (std::output_iterator<OutputIt, uint8_t> && !std::is_pointer_v<OutputIt>)
+HexResult string_unhexlify(std::string_view hex, OutputIt out)
+{
+    HexResult result;
+
+    do {
+        if (hex.size() % 2 != 0) {
+            result.eStatus = HexStatus::OddLength;
+            result.szErrorOffset = hex.size() - 1;
+            break;
+        }
+
+        uint8_t block[internal::g_szHexBlockSize];
+        size_t szTotal = unhexlified_size(hex.size());
+
+        for (size_t i = 0; i < szTotal; i += internal::g_szHexBlockSize) {
+            size_t szLen = std::min(internal::g_szHexBlockSize, szTotal - i);
+            HexResult partial = internal::hex_decode(hex.data() + hexlified_size(i), szLen, block, hexlified_size(i));
+            out = std::copy(block, block + partial.szWritten, out);
+            result.szWritten += partial.szWritten;
+            if (!partial) {
+                result.eStatus = partial.eStatus;
+                result.szErrorOffset = partial.szErrorOffset;
+                break;
+            }
+        }
+
+    } while (false);
+
+    return result;
+
+} /* string_unhexlify() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts formatted hexadecimal text to bytes stored in a caller-provided buffer, without throwing.
+ *
+ * Whitespace, the separators : , ; - . _ | and "0x" / "0X" byte prefixes are skipped between bytes, so the
+ * output of the formatting string_hexlify() overloads is accepted whatever its HexFormat. The two digits of
+ * a byte must be adjacent. Long runs of digits are decoded by the vector kernel.
+ *
+ * @param hex The input text.
+ * @param out The output buffer, must hold the decoded bytes (hex.size() / 2 is always enough).
+ * @return The outcome of the conversion: the number of bytes written and, on error,
+ *         the status and the offset of the first offending character.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline HexResult string_unhexlify_tolerant(std::string_view hex, std::span<uint8_t> out) noexcept
+{
+    const std::array<uint8_t, 256>& table = internal::g_au8HexTolerantTable;
+    const internal::HexDecodeFn pfnDecode = internal::hex_kernels().pfnDecode;
+    const char* pIn = hex.data();
+    const size_t szLen = hex.size();
+    uint8_t* pOut = out.data();
+    size_t i = 0;
+    size_t o = 0;
+    size_t szRun = 0;
+    size_t szLastRun = internal::g_szHexKernelRun;
+    HexResult result;
+
+    while (i < szLen) {
+        uint8_t high = table[static_cast<uint8_t>(pIn[i])];
+
+        if (internal::g_u8HexSeparatorChar == high) {
+            if (szRun > 0) {
+                szLastRun = szRun;
+                szRun = 0;
+            }
+            ++i;
+            continue;
+        }
+
+        /* when the runs of digits are long, let the kernel decode up to the next separator */
+        if ((0 == szRun) && (szLastRun >= internal::g_szHexKernelRun)) {
+            size_t szDone = pfnDecode(pIn + i, std::min((szLen - i) / 2, out.size() - o), pOut + o);
+            if (szDone > 0) {
+                i += hexlified_size(szDone);
+                o += szDone;
+                szRun += szDone;
+                continue;
+            }
+        }
+
+        /* optional "0x" prefix, then exactly two digits */
+        if (('0' == pIn[i]) && (i + 1 < szLen) && ('x' == (pIn[i + 1] | 0x20))) {
+            i += 2;
+            if (i >= szLen) {
+                result.eStatus = HexStatus::OddLength;
+                result.szErrorOffset = i - 1;
+                break;
+            }
+            high = table[static_cast<uint8_t>(pIn[i])];
+        }
+        if (high & 0xF0) {
+            result.eStatus = HexStatus::InvalidChar;
+            result.szErrorOffset = i;
+            break;
+        }
+        if (i + 1 >= szLen) {
+            result.eStatus = HexStatus::OddLength;
+            result.szErrorOffset = i;
+            break;
+        }
+        uint8_t low = table[static_cast<uint8_t>(pIn[i + 1])];
+        if (low & 0xF0) {
+            result.eStatus = HexStatus::InvalidChar;
+            result.szErrorOffset = i + 1;
+            break;
+        }
+        if (o >= out.size()) {
+            result.eStatus = HexStatus::BufferTooSmall;
+            result.szErrorOffset = i;
+            break;
+        }
+        pOut[o++] = static_cast<uint8_t>((high << 4) | low);
+        i += 2;
+        ++szRun;
+    }
+
+    result.szWritten = o;
+    return result;
+
+} /* string_unhexlify_tolerant() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts formatted hexadecimal text to a buffer of bytes, see string_unhexlify_tolerant().
+ * @param hex The input text.
+ * @param result The output buffer; on error it holds the bytes decoded before the offending character.
+ * @param pszErrorOffset Optional, receives the offset of the first offending character on error.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool string_unhexlify_tolerant(std::string_view hex, std::vector<uint8_t>& result, size_t* pszErrorOffset = nullptr)
+{
+    result.resize(unhexlified_size(hex.size()));
+    HexResult decoded = string_unhexlify_tolerant(hex, std::span<uint8_t>(result));
+
+    result.resize(decoded.szWritten);
+    if (!decoded && (nullptr != pszErrorOffset)) {
+        *pszErrorOffset = decoded.szErrorOffset;
+    }
+
+    return static_cast<bool>(decoded);
+
+} /* string_unhexlify_tolerant() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a buffer of any trivially copyable type to hexadecimal characters stored in a
+ *        caller-provided buffer, including the endianness marker.
+ * @tparam T The type of elements in the input buffer.
+ * @param data The input elements.
+ * @param out The output buffer, must hold at least hexlified_size_any<T>(data.size()) characters.
+ * @param endian The endianness to use for the conversion.
+ * @return The number of characters written, 0 if the output buffer is too small.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename T>
+constexpr size_t string_hexlify_any(std::span<const T> data, std::span<char> out, Endianness endian = Endianness::Little) noexcept
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    size_t szWritten = 0;
+
+    do {
+        if (out.size() < hexlified_size_any<T>(data.size())) {
+            break;
+        }
+
+        uint8_t marker = internal::endianness_marker(endian);
+        internal::hex_encode_scalar(&marker, 1, out.data());
+        char* pOut = out.data() + hexlified_size(1);
+
+        if (endian == Endianness::Little) {
+            internal::hexlify_elements<Endianness::Little>(data.data(), data.size(), pOut);
+        } else {
+            internal::hexlify_elements<Endianness::Big>(data.data(), data.size(), pOut);
+        }
+
+        szWritten = hexlified_size_any<T>(data.size());
+
+    } while (false);
+
+    return szWritten;
+
+} /* string_hexlify_any() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a buffer of any trivially copyable type to a hexadecimal string.
+ * @tparam T The type of elements in the input buffer.
+ * @param data The input buffer of elements.
+ * @param out The output string to store the hexadecimal representation.
+ * @param endian The endianness to use for the conversion.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename T>
+bool string_hexlify_any(const std::vector<T>& data, std::string& out, Endianness endian = Endianness::Little)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    out.resize(hexlified_size_any<T>(data.size()));
+    string_hexlify_any(std::span<const T>(data), std::span<char>(out), endian);
+
+    return true;
+
+} /* string_hexlify_any() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a hexadecimal string to elements of any trivially copyable type stored in a
+ *        caller-provided buffer, without throwing.
+ * @tparam T The type of elements in the output buffer.
+ * @param hex The input hexadecimal string, starting with the endianness marker.
+ * @param out The output buffer, must hold at least (unhexlified_size(hex.size()) - 1) / sizeof(T) elements.
+ * @return The outcome of the conversion; szWritten counts bytes, not elements.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename T>
+constexpr HexResult string_unhexlify_any(std::string_view hex, std::span<T> out) noexcept
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    HexResult result;
+
+    do {
+        if (hex.size() % 2 != 0) {
+            result.eStatus = HexStatus::OddLength;
+            result.szErrorOffset = hex.size() - 1;
+            break;
+        }
+
+        uint8_t marker = 0;
+        if ((hex.size() < 2) || (1 != internal::hex_decode_scalar(hex.data(), 1, &marker))) {
+            result.eStatus = HexStatus::InvalidMarker;
+            break;
+        }
+
+        Endianness targetEndian = Endianness::Little;
+        if (marker == internal::endianness_marker(Endianness::Little)) targetEndian = Endianness::Little;
+        else if (marker == internal::endianness_marker(Endianness::Big)) targetEndian = Endianness::Big;
+        else {
+            result.eStatus = HexStatus::InvalidMarker;
+            break;
+        }
+
+        size_t byteCount = unhexlified_size(hex.size()) - 1;
+        if (byteCount % sizeof(T) != 0) {
+            result.eStatus = HexStatus::SizeMismatch;
+            result.szErrorOffset = hex.size();
+            break;
+        }
+
+        if (out.size_bytes() < byteCount) {
+            result.eStatus = HexStatus::BufferTooSmall;
+            result.szErrorOffset = hexlified_size(1 + out.size_bytes());
+            break;
+        }
+
+        const char* pHex = hex.data() + hexlified_size(1);
+        size_t szCount = byteCount / sizeof(T);
+
+        if (targetEndian == Endianness::Little) {
+            result = internal::unhexlify_elements<Endianness::Little>(pHex, szCount, out.data(), hexlified_size(1));
+        } else {
+            result = internal::unhexlify_elements<Endianness::Big>(pHex, szCount, out.data(), hexlified_size(1));
+        }
+
+    } while (false);
+
+    return result;
+
+} /* string_unhexlify_any() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a hexadecimal string to a buffer of any trivially copyable type.
+ * @tparam T The type of elements in the output buffer.
+ * @param hex The input hexadecimal string.
+ * @param result The output buffer to store the elements.
+ * @return True if the conversion was successful, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename T>
+bool string_unhexlify_any(std::string_view hex, std::vector<T>& result)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    bool bRetVal = false;
+
+    do {
+        if (hex.size() < 2 || hex.size() % 2 != 0) {
+            break;
+        }
+
+        /* decode straight into the result storage, the size is validated by the span overload */
+        result.resize((unhexlified_size(hex.size()) - 1) / sizeof(T));
+        if (!string_unhexlify_any(hex, std::span<T>(result))) {
+            result.clear();
+            break;
+        }
+
+        bRetVal = true;
+
+    } while (false);
+
+    return bRetVal;
+
+} /* string_unhexlify_any() */
+
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Fixed-size string usable as a template argument, carries a hex literal to the compile-time API.
+ * @tparam N The size of the literal, including the terminating null character.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<size_t N>
+struct HexLiteral
+{
+    char acData[N] = {};  ///< The literal characters, null-terminated.
+
+    consteval HexLiteral(const char (&pstrLiteral)[N])
+    {
+        std::copy_n(pstrLiteral, N, acData);
+    }
+
+    /**
+     * @brief Returns the number of characters, without the terminating null character.
+     */
+    constexpr size_t size() const noexcept { return N - 1; }
+
+    /**
+     * @brief Returns true if every character is a hexadecimal digit.
+     */
+    constexpr bool valid() const noexcept
+    {
+        for (size_t i = 0; i < size(); ++i) {
+            if (internal::g_u8InvalidHexChar == internal::hex_char_to_byte(acData[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts an array of bytes to hexadecimal characters, usable at compile time.
+ * @param data The input bytes.
+ * @return The hexadecimal characters (not null-terminated).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<size_t N>
+constexpr std::array<char, hexlified_size(N)> hexlify_array(const std::array<uint8_t, N>& data) noexcept
+{
+    std::array<char, hexlified_size(N)> result{};
+    internal::hex_encode_scalar(data.data(), N, result.data());
+
+    return result;
+
+} /* hexlify_array() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts an array of elements to the string_hexlify_any() representation, usable at compile time.
+ * @tparam E The endianness to use for the conversion.
+ * @param data The input elements.
+ * @return The hexadecimal characters including the endianness marker (not null-terminated).
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<Endianness E = Endianness::Little, typename T, size_t N>
+constexpr std::array<char, hexlified_size_any<T>(N)> hexlify_any_array(const std::array<T, N>& data) noexcept
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    std::array<char, hexlified_size_any<T>(N)> result{};
+    uint8_t marker = internal::endianness_marker(E);
+    internal::hex_encode_scalar(&marker, 1, result.data());
+    internal::hexlify_elements<E>(data.data(), N, result.data() + hexlified_size(1));
+
+    return result;
+
+} /* hexlify_any_array() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a hex literal to bytes at compile time, e.g. unhexlify_literal<"DEADBEEF">().
+ * @tparam Hex The hex literal; invalid characters or an odd length are reported at compile time.
+ * @return The decoded bytes.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<HexLiteral Hex>
+consteval std::array<uint8_t, unhexlified_size(Hex.size())> unhexlify_literal() noexcept
+{
+    static_assert(Hex.size() % 2 == 0, "hex literal must have an even number of digits");
+    static_assert(Hex.valid(), "hex literal contains non hexadecimal characters");
+
+    std::array<uint8_t, unhexlified_size(Hex.size())> result{};
+    internal::hex_decode_scalar(Hex.acData, result.size(), result.data());
+
+    return result;
+
+} /* unhexlify_literal() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Converts a string_hexlify_any() literal to elements at compile time,
+ *        e.g. unhexlify_any_literal<uint32_t, "4C78563412">().
+ * @tparam T The element type.
+ * @tparam Hex The hex literal, starting with the endianness marker; errors are reported at compile time.
+ * @return The decoded elements.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+template<typename T, HexLiteral Hex>
+consteval std::array<T, (unhexlified_size(Hex.size()) - 1) / sizeof(T)> unhexlify_any_literal() noexcept
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    static_assert(Hex.size() >= 2 && Hex.size() % 2 == 0, "hex literal must have an even number of digits and a marker");
+    static_assert(Hex.valid(), "hex literal contains non hexadecimal characters");
+    static_assert((unhexlified_size(Hex.size()) - 1) % sizeof(T) == 0, "hex literal is not a whole number of elements");
+
+    constexpr uint8_t marker = static_cast<uint8_t>((internal::hex_char_to_byte(Hex.acData[0]) << 4) | internal::hex_char_to_byte(Hex.acData[1]));
+    static_assert(marker == internal::endianness_marker(Endianness::Little) || marker == internal::endianness_marker(Endianness::Big),
+                  "hex literal must start with the endianness marker 4C ('L') or 42 ('B')");
+
+    std::array<T, (unhexlified_size(Hex.size()) - 1) / sizeof(T)> result{};
+    if constexpr (marker == internal::endianness_marker(Endianness::Little)) {
+        internal::unhexlify_elements<Endianness::Little>(Hex.acData + hexlified_size(1), result.size(), result.data());
+    } else {
+        internal::unhexlify_elements<Endianness::Big>(Hex.acData + hexlified_size(1), result.size(), result.data());
+    }
+
+    return result;
+
+} /* unhexlify_any_literal() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @class HexEncoder
+ * @brief Incremental hex encoder: feeds arbitrarily large inputs chunk by chunk with constant memory.
+ *
+ * Every byte maps to exactly two characters, so the encoder carries no state between chunks apart
+ * from the running byte count; the output buffer is reused across calls.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+class HexEncoder
+{
+public:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Encodes the next chunk of input.
+     * @param chunk The input bytes.
+     * @return The hexadecimal characters of the chunk, valid until the next call on this encoder.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    std::string_view update(std::span<const uint8_t> chunk)
+    {
+        m_strBuffer.resize(hexlified_size(chunk.size()));
+        internal::hex_kernels().pfnEncode(chunk.data(), chunk.size(), m_strBuffer.data());
+        m_szTotal += chunk.size();
+
+        return m_strBuffer;
+
+    } /* update() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Terminates the stream and makes the encoder ready for a new one.
+     * @return The remaining output, always empty for the hex encoding.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    std::string_view finish() noexcept
+    {
+        m_szTotal = 0;
+        return {};
+
+    } /* finish() */
+
+
+    /**
+     * @brief Returns the number of bytes encoded since the stream started.
+     */
+    size_t total() const noexcept { return m_szTotal; }
+
+
+private:
+
+    std::string m_strBuffer;  ///< Output buffer reused across updates.
+    size_t m_szTotal = 0;     ///< Bytes encoded since the stream started.
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @class HexDecoder
+ * @brief Incremental hex decoder: feeds arbitrarily large inputs chunk by chunk with constant memory.
+ *
+ * A chunk may end in the middle of a byte; the dangling nibble is kept and completed by the next chunk.
+ * Once an error is detected the decoder stops, and result() reports the status and the offset of the
+ * offending character counted from the start of the stream.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+class HexDecoder
+{
+public:
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Constructs a decoder.
+     * @param bSkipWhitespace If true, whitespace between the hexadecimal characters is ignored (e.g. line breaks).
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    explicit HexDecoder(bool bSkipWhitespace = false)
+        : m_bSkipWhitespace(bSkipWhitespace)
+    {}
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Decodes the next chunk of input.
+     * @param chunk The input characters.
+     * @return The bytes decoded from the chunk, valid until the next call on this decoder.
+     *         On error only the bytes preceding the offending character are returned.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    std::span<const uint8_t> update(std::string_view chunk)
+    {
+        if (m_bFinished) {
+            m_reset();
+        }
+
+        m_vBuffer.resize(unhexlified_size(chunk.size()) + 1);
+        size_t szOut = 0;
+
+        if (m_result) {
+            size_t szPos = 0;
+            while (szPos < chunk.size()) {
+                if (m_bSkipWhitespace && is_whitespace(chunk[szPos])) {
+                    ++szPos;
+                    continue;
+                }
+
+                size_t szEnd = m_bSkipWhitespace ? find_whitespace(chunk, szPos) : chunk.size();
+                if (!m_decode_run(chunk, szPos, szEnd, szOut)) {
+                    break;
+                }
+                szPos = szEnd;
+            }
+            m_szConsumed += chunk.size();
+        }
+
+        return std::span<const uint8_t>(m_vBuffer.data(), szOut);
+
+    } /* update() */
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Terminates the stream; the next update() starts a new one.
+     * @return True if the whole stream was valid hex with an even number of digits, false otherwise.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    bool finish() noexcept
+    {
+        if (m_result && m_bPending) {
+            m_result.eStatus = HexStatus::OddLength;
+            m_result.szErrorOffset = m_szPendingOffset;
+        }
+        m_bFinished = true;
+
+        return static_cast<bool>(m_result);
+
+    } /* finish() */
+
+
+    /**
+     * @brief Returns the outcome of the current (or last finished) stream: status, bytes written, error offset.
+     */
+    const HexResult& result() const noexcept { return m_result; }
+
+
+private:
+
+    static bool is_whitespace(char c) noexcept
+    {
+        return (' ' == c) || ('\n' == c) || ('\r' == c) || ('\t' == c);
+    }
+
+    static size_t find_whitespace(std::string_view chunk, size_t szPos) noexcept
+    {
+        while ((szPos < chunk.size()) && !is_whitespace(chunk[szPos])) {
+            ++szPos;
+        }
+        return szPos;
+    }
+
+
+    /*--------------------------------------------------------------------------------------------------------*/
+    /**
+     * @brief Decodes the run chunk[szBegin, szEnd) which contains no whitespace, completing a pending nibble.
+     * @return False if an invalid character was found.
+     */
+    /*--------------------------------------------------------------------------------------------------------*/
+
+    bool m_decode_run(std::string_view chunk, size_t szBegin, size_t szEnd, size_t& szOut)
+    {
+        if (m_bPending) {
+            uint8_t low = internal::hex_char_to_byte(chunk[szBegin]);
+            if (internal::g_u8InvalidHexChar == low) {
+                return m_fail(m_szConsumed + szBegin);
+            }
+            m_vBuffer[szOut++] = static_cast<uint8_t>((m_u8PendingHigh << 4) | low);
+            ++m_result.szWritten;
+            m_bPending = false;
+            ++szBegin;
+        }
+
+        size_t szPairs = unhexlified_size(szEnd - szBegin);
+        HexResult decoded = internal::hex_decode(chunk.data() + szBegin, szPairs, m_vBuffer.data() + szOut, m_szConsumed + szBegin);
+        szOut += decoded.szWritten;
+        m_result.szWritten += decoded.szWritten;
+        if (!decoded) {
+            return m_fail(decoded.szErrorOffset);
+        }
+
+        size_t szTail = szBegin + hexlified_size(szPairs);
+        if (szTail < szEnd) {
+            m_u8PendingHigh = internal::hex_char_to_byte(chunk[szTail]);
+            if (internal::g_u8InvalidHexChar == m_u8PendingHigh) {
+                return m_fail(m_szConsumed + szTail);
+            }
+            m_bPending = true;
+            m_szPendingOffset = m_szConsumed + szTail;
+        }
+
+        return true;
+
+    } /* m_decode_run() */
+
+    void m_reset() noexcept
+    {
+        m_result = HexResult{};
+        m_szConsumed = 0;
+        m_bPending = false;
+        m_bFinished = false;
+    }
+
+    bool m_fail(size_t szOffset) noexcept
+    {
+        m_result.eStatus = HexStatus::InvalidChar;
+        m_result.szErrorOffset = szOffset;
+        return false;
+    }
+
+    std::vector<uint8_t> m_vBuffer;      ///< Output buffer reused across updates.
+    HexResult m_result;                  ///< Outcome of the current stream.
+    size_t m_szConsumed = 0;             ///< Characters consumed since the stream started.
+    size_t m_szPendingOffset = 0;        ///< Stream offset of the pending high nibble.
+    uint8_t m_u8PendingHigh = 0;         ///< High nibble waiting for its low half.
+    bool m_bPending = false;             ///< True if a high nibble is pending.
+    bool m_bFinished = false;            ///< True once finish() was called, the next update() restarts.
+    bool m_bSkipWhitespace = false;      ///< True if whitespace is ignored.
+};
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Hexlifies an input stream into an output stream with constant memory.
+ * @param in The binary input stream.
+ * @param out The output stream receiving the hexadecimal characters.
+ * @param szChunkSize Number of bytes read per step.
+ * @return True if the whole input was converted and written, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool hexlify_stream(std::istream& in, std::ostream& out, size_t szChunkSize = internal::g_szHexStreamChunkSize)
+{
+    std::vector<uint8_t> vChunk(std::max<size_t>(szChunkSize, 1));
+    HexEncoder encoder;
+
+    while (in && out) {
+        in.read(reinterpret_cast<char*>(vChunk.data()), static_cast<std::streamsize>(vChunk.size()));
+        std::streamsize bytesRead = in.gcount();
+        if (bytesRead <= 0) {
+            break;
+        }
+        std::string_view hex = encoder.update(std::span<const uint8_t>(vChunk.data(), static_cast<size_t>(bytesRead)));
+        out.write(hex.data(), static_cast<std::streamsize>(hex.size()));
+    }
+    encoder.finish();
+
+    return !in.bad() && static_cast<bool>(out);
+
+} /* hexlify_stream() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Unhexlifies an input stream into an output stream with constant memory.
+ * @param in The input stream holding the hexadecimal characters.
+ * @param out The binary output stream.
+ * @param szChunkSize Number of characters read per step.
+ * @param bSkipWhitespace If true, whitespace (e.g. line breaks) in the input is ignored.
+ * @param pResult Optional, receives the outcome of the conversion (status and error offset).
+ * @return True if the whole input was valid and written, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool unhexlify_stream(std::istream& in, std::ostream& out, size_t szChunkSize = internal::g_szHexStreamChunkSize, bool bSkipWhitespace = true, HexResult* pResult = nullptr)
+{
+    std::vector<char> vChunk(std::max<size_t>(szChunkSize, 1));
+    HexDecoder decoder(bSkipWhitespace);
+
+    while (in && out && decoder.result()) {
+        in.read(vChunk.data(), static_cast<std::streamsize>(vChunk.size()));
+        std::streamsize charsRead = in.gcount();
+        if (charsRead <= 0) {
+            break;
+        }
+        std::span<const uint8_t> bytes = decoder.update(std::string_view(vChunk.data(), static_cast<size_t>(charsRead)));
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    bool bRetVal = decoder.finish() && !in.bad() && static_cast<bool>(out);
+    if (nullptr != pResult) {
+        *pResult = decoder.result();
+    }
+
+    return bRetVal;
+
+} /* unhexlify_stream() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Hexlifies the content of a file descriptor into another one with constant memory.
+ * @param iFdIn The input file descriptor, read until end of file.
+ * @param iFdOut The output file descriptor.
+ * @param szChunkSize Number of bytes read per step.
+ * @return True if the whole input was converted and written, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool hexlify_fd(int iFdIn, int iFdOut, size_t szChunkSize = internal::g_szHexStreamChunkSize)
+{
+    std::vector<uint8_t> vChunk(std::max<size_t>(szChunkSize, 1));
+    HexEncoder encoder;
+    bool bRetVal = true;
+
+    while (bRetVal) {
+        long bytesRead = internal::fd_read(iFdIn, vChunk.data(), vChunk.size());
+        if (bytesRead <= 0) {
+            bRetVal = (0 == bytesRead);
+            break;
+        }
+        std::string_view hex = encoder.update(std::span<const uint8_t>(vChunk.data(), static_cast<size_t>(bytesRead)));
+        bRetVal = internal::fd_write_all(iFdOut, hex.data(), hex.size());
+    }
+    encoder.finish();
+
+    return bRetVal;
+
+} /* hexlify_fd() */
+
+
+
+/*--------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Unhexlifies the content of a file descriptor into another one with constant memory.
+ * @param iFdIn The input file descriptor holding the hexadecimal characters, read until end of file.
+ * @param iFdOut The binary output file descriptor.
+ * @param szChunkSize Number of characters read per step.
+ * @param bSkipWhitespace If true, whitespace (e.g. line breaks) in the input is ignored.
+ * @param pResult Optional, receives the outcome of the conversion (status and error offset).
+ * @return True if the whole input was valid and written, false otherwise.
+ */
+/*--------------------------------------------------------------------------------------------------------*/
+
+inline bool unhexlify_fd(int iFdIn, int iFdOut, size_t szChunkSize = internal::g_szHexStreamChunkSize, bool bSkipWhitespace = true, HexResult* pResult = nullptr)
+{
+    std::vector<char> vChunk(std::max<size_t>(szChunkSize, 1));
+    HexDecoder decoder(bSkipWhitespace);
+    bool bIoOk = true;
+
+    while (bIoOk && decoder.result()) {
+        long charsRead = internal::fd_read(iFdIn, vChunk.data(), vChunk.size());
+        if (charsRead <= 0) {
+            bIoOk = (0 == charsRead);
+            break;
+        }
+        std::span<const uint8_t> bytes = decoder.update(std::string_view(vChunk.data(), static_cast<size_t>(charsRead)));
+        bIoOk = internal::fd_write_all(iFdOut, bytes.data(), bytes.size());
+    }
+
+    bool bRetVal = decoder.finish() && bIoOk;
+    if (nullptr != pResult) {
+        *pResult = decoder.result();
+    }
+
+    return bRetVal;
+
+} /* unhexlify_fd() */
 
 } // namespace hexutils
 